@@ -0,0 +1,26 @@
+#ifndef ALIAS_TABLE_HPP
+#define ALIAS_TABLE_HPP
+
+#include <vector>
+
+class AliasTable {
+    private:
+        int rowNumber;
+        int outcomeNumber;
+        std::vector<double> thresholds;
+        std::vector<int> aliases;
+        std::vector<int> smallOutcomes;
+        std::vector<int> largeOutcomes;
+        std::vector<double> scaledProbabilities;
+
+    public:
+        explicit AliasTable(int rows = 0, int outcomes = 0);
+        void assign(int rows, int outcomes);
+        void setDistribution(int row, const double *probabilities);
+        int sample(int row) const;
+        int sample(int row, double value) const;
+        int getRowNumber() const;
+        int getOutcomeNumber() const;
+};
+
+#endif
\ No newline at end of file
@@ -5,7 +5,7 @@
 
 class AsynchronousPolicyIterationPlayer : public PolicyIterationPlayer {
     private:
-        State* currentState;
+        int currentState;
         int iteration;
         int maximumIteration;
         void performEvaluationStep() override;
@@ -1,17 +1,24 @@
 #ifndef ASYNCHRONOUS_VALUE_ITERATION_PLAYER_HPP
 #define ASYNCHRONOUS_VALUE_ITERATION_PLAYER_HPP
 
+#include <queue>
 #include "ValueIterationPlayer.hpp"
 
 class AsynchronousValueIterationPlayer : public ValueIterationPlayer {
     private:
         int iteration;
         int maximumIteration;
+        bool prioritizedSweeping;
+        std::vector<double> priorities;
+        std::priority_queue<std::pair<double, int>> urgentStates;
+        void prioritizeState(int s);
+        void performPrioritizedSweeping();
         void performRepetitionStep() override;
         void performConstructionStep() override;
 
     public:
-        AsynchronousValueIterationPlayer(Maze *m, double gamma, double theta, int maximumIteration);
+        AsynchronousValueIterationPlayer(Maze *m, double gamma, double theta, int maximumIteration,
+                bool prioritizedSweeping = false);
         ~AsynchronousValueIterationPlayer() override;
 };
 
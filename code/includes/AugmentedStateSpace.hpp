@@ -0,0 +1,51 @@
+#ifndef AUGMENTED_STATE_SPACE_HPP
+#define AUGMENTED_STATE_SPACE_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "Maze.hpp"
+
+class AugmentedStateSpace {
+    private:
+        const MazeLayout *layout;
+        int positionNumber;
+        std::vector<uint64_t> layerSwitches;
+        std::unordered_map<uint64_t, int> layerIndices;
+        std::vector<char> reachable;
+        std::vector<int> startingStates;
+        std::vector<Maze::Transition> transitions;
+        std::vector<double> rewards;
+        std::vector<int> nontrivialStates;
+        std::vector<char> nontrivial;
+        std::vector<int> predecessorOffsets;
+        std::vector<int> predecessors;
+        std::vector<int> representatives;
+        int layerOf(uint64_t switches);
+        uint64_t switchesAfterVisit(uint64_t switches, int position) const;
+        double rewardOfPosition(uint64_t switches, int position) const;
+        void markReachable(int s, std::vector<int> *frontier);
+        void exploreLayers();
+        void buildTransitions();
+        void buildPredecessorIndex();
+        void buildRepresentatives();
+
+    public:
+        explicit AugmentedStateSpace(const MazeLayout *layout);
+        int getStateNumber() const;
+        int getLayerNumber() const;
+        int getPositionNumber() const;
+        int positionOfState(int s) const;
+        bool stateIsTerminal(int s) const;
+        bool stateIsNontrivial(int s) const;
+        double getReward(int s) const;
+        const Maze::Transition* getTransitions(int s, Maze::Actions action) const;
+        const int* getPredecessors(int s, int *count) const;
+        const std::vector<int>& getStartingStates() const;
+        int getNontrivialStateNumber() const;
+        int getNontrivialState(int index) const;
+        int getRandomNontrivialState() const;
+        int representativeState(int position) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#ifndef BATCH_MAZE_HPP
+#define BATCH_MAZE_HPP
+
+#include <vector>
+#include "Maze.hpp"
+
+class BatchMaze {
+    private:
+        const MazeLayout *layout;
+        int laneNumber;
+        std::vector<MazeDynamics> dynamics;
+        std::vector<double> rotationValues;
+        int warpResult(int lane, int stateIndex) const;
+
+    public:
+        BatchMaze(const MazeLayout *layout, int laneNumber);
+        int getLaneNumber() const;
+        const MazeLayout* getLayout() const;
+        int startEpisode(int lane);
+        void step(const int *states, const Maze::Actions *actions, int *nextStates, double *rewards, char *done);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef CONFIGURATION_HPP
+#define CONFIGURATION_HPP
+
+#include <cstdint>
+#include <string>
+
+class Configuration {
+    private:
+        int sweepThreads;
+        int jobs;
+        int lanes;
+        bool prioritizedSweeping;
+        bool exactEvaluation;
+        bool analyticEvaluation;
+        uint64_t seed;
+        std::string generatorSpecification;
+        std::string generatorOutputFile;
+        std::string conversionInputFile;
+        std::string conversionOutputFile;
+        static bool threadNumberFromArgument(const char *argument, int *threads);
+        static bool laneNumberFromArgument(const char *argument, int *lanes);
+        static bool seedFromArgument(const char *argument, uint64_t *seed);
+
+    public:
+        Configuration();
+        static Configuration fromArguments(int argc, char *argv[]);
+        int getSweepThreads() const;
+        bool usePrioritizedSweeping() const;
+        bool useExactEvaluation() const;
+        bool useAnalyticEvaluation() const;
+        int getJobs() const;
+        int getLanes() const;
+        uint64_t getSeed() const;
+        bool writesGeneratedMaze() const;
+        const std::string& getGeneratorSpecification() const;
+        const std::string& getGeneratorOutputFile() const;
+        bool convertsMaze() const;
+        const std::string& getConversionInputFile() const;
+        const std::string& getConversionOutputFile() const;
+};
+
+#endif
\ No newline at end of file
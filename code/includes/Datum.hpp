@@ -14,13 +14,13 @@ class Datum {
         std::string mazeIdentifier;
         std::vector<Player::Types> players;
         std::map<Player::Types, std::vector<double>> timings;
-        std::map<Player::Types, std::map<std::tuple<int, int, Maze::Actions>, double>> policies;
+        std::map<Player::Types, std::vector<double>> policies;
         std::map<Player::Types, std::vector<double>> averageRewards;
 
     public:
         Datum(int id, int mazeWidth, int mazeHeight, std::string mazeIdentifier, std::vector<Player::Types> players,
                 std::map<Player::Types, std::vector<double>> timings,
-                std::map<Player::Types, std::map<std::tuple<int, int, Maze::Actions>, double>> policies,
+                std::map<Player::Types, std::vector<double>> policies,
                 std::map<Player::Types, std::vector<double>> averageRewards);
         explicit Datum(int id);
         ~Datum();
@@ -32,7 +32,9 @@ class Datum {
         std::string playerAverageRewards();
         void writeDatumToFiles();
         std::string getMazeIdentifier();
-        std::map<std::tuple<int, int, Maze::Actions>, double> getPolicy(Player::Types type);
+        int getMazeWidth();
+        int getMazeHeight();
+        const std::vector<double>& getPolicy(Player::Types type);
 };
 
 #endif
\ No newline at end of file
@@ -3,13 +3,25 @@
 
 #include <cmath>
 #include "Player.hpp"
+#include "AugmentedStateSpace.hpp"
 
 class DynamicProgrammingPlayer : public Player {
     protected:
+        static constexpr double OCCUPANCY_TOLERANCE = 1e-9;
+        static constexpr int OCCUPANCY_SWEEPS = 16;
         double theta;
-        std::map<State*, double> oldStateValues;
-        void copyStateValues(std::map<State*, double> *source, std::map<State*, double> *target);
-        State* randomNontrivialState();
+        AugmentedStateSpace *space;
+        std::vector<int> representatives;
+        std::vector<double> oldStateValues;
+        bool inPlaceBackups;
+        void copyStateValues(std::vector<double> *source, std::vector<double> *target);
+        void useInPlaceBackups();
+        double backupValue(int s);
+        int randomNontrivialState();
+        void initialiseAugmentedStateValues();
+        std::vector<double> stateOccupancies();
+        void chooseRepresentatives();
+        int representativeState(int position) override;
 
     public:
         DynamicProgrammingPlayer(Maze *m, double gamma, double theta);
@@ -1,38 +1,43 @@
 #ifndef EXPERIMENT_HPP
 #define EXPERIMENT_HPP
 
+#include <mutex>
 #include "Run.hpp"
+#include "TaskScheduler.hpp"
 
 class Experiment {
     private:
         static constexpr int EVALUATION_RUNS = 1e2;
         int runNumber;
+        Configuration configuration;
         std::vector<std::string> selectedMazes;
         std::vector<Player::Types> selectedPlayers;
-        std::map<std::tuple<std::string, Player::Types>, std::map<std::tuple<int, int, Maze::Actions>, double>>
-            averagePolicies;
+        std::map<std::tuple<std::string, Player::Types>, std::vector<double>> averagePolicies;
+        std::map<std::string, int> mazeRunNumbers;
+        std::vector<std::string> runMazeIdentifiers;
         std::vector<std::string> mazeIdentifiers;
-        std::vector<Datum> data;
         std::map<std::tuple<std::string, Player::Types>, std::vector<double>> averagePolicyRewards;
         std::string runMazeIdentifier(int runIndex);
         static void clearOldData();
+        void foldPolicies(Datum *datum);
         void conductRuns();
-        bool mazeIdentifierAlreadyPresent(std::string mazeIdentifier);
+        static bool mazeIdentifierAlreadyPresent(const std::vector<std::string>& identifiers,
+                const std::string& mazeIdentifier);
         std::vector<std::string> getMazeIdentifiers();
-        std::map<std::tuple<int, int, Maze::Actions>, double> averagePolicy(const std::string& mazeIdentifier,
-                Player::Types type);
         static void reportProgress(int current, int maximum);
         void getAveragePolicies();
-        std::map<State*, std::vector<double>> convertedPolicy(Maze *m, Player::Types type);
-        void evaluateAveragePolicy(int mazeIdentifierIndex, Player::Types type);
+        std::vector<double> convertedPolicy(Maze *m, Player::Types type);
+        void evaluateAveragePolicies(int mazeIdentifierIndex, TaskScheduler *scheduler);
         void evaluateAveragePolicies();
         std::string averagePolicyRewardAsString(std::string mazeIdentifier, Player::Types type);
         void writeAveragePoliciesRewards();
         void writeData();
 
     public:
-        Experiment(std::vector<Player::Types> selectedPlayers, int runNumber = 1e2);
-        Experiment(std::vector<Player::Types> selectedPlayers, std::vector<std::string> selectedMazes);
+        Experiment(std::vector<Player::Types> selectedPlayers, int runNumber = 1e2,
+                Configuration configuration = Configuration());
+        Experiment(std::vector<Player::Types> selectedPlayers, std::vector<std::string> selectedMazes,
+                Configuration configuration = Configuration());
         ~Experiment();
         void conductExperiment();
 };
@@ -5,15 +5,22 @@
 
 class ExploitPlayer : Player {
     private:
+        static constexpr double REMAINDER_TOLERANCE = 1e-12;
+        int laneNumber;
         std::vector<double> rewards;
+        std::vector<double> rewardTotals;
+        void solveMazeInBatch();
+        void normalisedStatePolicy(int s, double *probabilities);
 
     public:
-        ExploitPlayer(Maze *m, std::map<State*, std::vector<double>> policy);
+        ExploitPlayer(Maze *m, std::vector<double> policy, int lanes = 1);
         ~ExploitPlayer() override;
-        State *initialState();
-        State *nextState(State *s);
+        int initialState();
+        int nextState(int s);
         void solveMaze() override;
         double getRewardTotal();
+        std::vector<double> getRewardTotals();
+        bool expectedRewardTotal(int episodeNumber, double *total);
 };
 
 #endif
\ No newline at end of file
@@ -2,25 +2,27 @@
 #define LEARNING_PLAYER_HPP
 
 #include "Player.hpp"
+#include "QTable.hpp"
 
 class LearningPlayer : public Player {
     protected:
         static constexpr double INITIAL_STATE_ACTION_VALUE = 0.0;
         std::vector<double> rewards;
         std::vector<double> totalRewardPerEpisode;
-        std::map<std::tuple<State*, Maze::Actions>, double> stateActionValues;
+        QTable stateActionValues;
+        static int stateActionIndex(std::tuple<int, Maze::Actions> stateActionPair);
         void initialiseStateActionValues();
-        virtual std::tuple<State*, Maze::Actions> initialStateActionPair() = 0;
-        virtual std::tuple<State*, Maze::Actions> nextStateActionPair(std::tuple<State*,
+        virtual std::tuple<int, Maze::Actions> initialStateActionPair() = 0;
+        virtual std::tuple<int, Maze::Actions> nextStateActionPair(std::tuple<int,
                 Maze::Actions> currentPair) = 0;
-        virtual void generateEpisode(std::tuple<State*, Maze::Actions> startStateActionPair) = 0;
-        virtual Maze::Actions greedyAction(State *s);
+        virtual void generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) = 0;
+        virtual Maze::Actions greedyAction(int s);
         void addRewardsToTotalRewardPerEpisode();
 
     public:
         LearningPlayer(Maze *m, double gamma, int T, bool initialiseStochastic = false);
         ~LearningPlayer() override;
-        void setStateActionValue(State *s, Maze::Actions action, double value);
+        void setStateActionValue(int s, Maze::Actions action, double value);
         std::vector<double> getTotalRewardPerEpisode() override;
 };
 
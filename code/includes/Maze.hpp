@@ -4,7 +4,10 @@
 #include <vector>
 #include <tuple>
 #include <string>
+#include <memory>
 #include "State.hpp"
+#include "MazeLayout.hpp"
+#include "MazeDynamics.hpp"
 
 class Maze {
     public:
@@ -16,48 +19,46 @@ class Maze {
         static constexpr double NEGATIVE_REWARD = -1.0;
         static constexpr double GOAL_REWARD = 1.0;
         static constexpr int MAZES_AVAILABLE = 4;
+        typedef MazeLayout::Transition Transition;
 
     private:
-        std::tuple<double, double, double, double> moveProbabilities;
-        int width;
-        int height;
-        const std::string mazeIdentifier;
-        std::vector<State> states;
-        std::vector<State*> gateStates;
-        std::vector<State*> goalStates;
-        static State::Types typeFromInput(char input);
-        void getMazeDimensionsFromInput();
-        void getMazeDimensionsFromFile(std::ifstream *inputStream);
-        void getMazeStatesFromInput();
-        void getMazeStatesFromFile(std::ifstream *inputStream);
-        void getMazeSpecialStates();
+        std::shared_ptr<const MazeLayout> layout;
+        MazeDynamics dynamics;
         bool shouldStartAtRandomPosition();
+        int actualRotation();
         Actions actualAction(Actions chosenAction);
-        bool moveIsOutOfBounds(int x, int y);
-        bool moveShouldFail(int x, int y);
-        State* getWarpStateResult(State *s);
-        void openGates();
-        static void removeSnack(State *s);
-        State* getSpecialStateResult(State *s);
+        int getWarpStateResult(int stateIndex);
+        int getSpecialStateResult(int stateIndex);
 
     public:
-        std::vector<State*> startingStates;
+        explicit Maze(std::shared_ptr<const MazeLayout> layout);
         explicit Maze(std::tuple<double, double, double, double> mps, const std::string& inputFile = "");
         explicit Maze(const std::string& inputFile = "");
         ~Maze();
-        static bool stateIsIntraversible(State *s);
-        static bool stateIsTerminal(State *s);
+        bool stateIsIntraversible(int stateIndex);
+        bool stateIsTerminal(int stateIndex);
         int indexFromCoordinates(int x, int y);
         static Actions actionFromIndex(int index);
         void resetMaze();
-        std::vector<State>* getStates();
-        static double getReward(State *state);
-        State* getState(int index);
-        State* getStartingState();
+        const MazeLayout* getLayout();
+        MazeDynamics getDynamics();
+        void setDynamics(MazeDynamics dynamics);
+        int getStateNumber();
+        int getCellNumber();
+        bool isStatic();
+        int getCellOfState(int stateIndex);
+        int getStateOfCell(int cellIndex);
+        int getStateX(int stateIndex);
+        int getStateY(int stateIndex);
+        State::Types getStateType(int stateIndex);
+        double getReward(int stateIndex);
+        int getStartingState();
+        int getRandomNontrivialState();
         double getActionProbability(int relativeIndex);
-        State* getNextStateDeterministic(State *state, Actions action);
-        State* getNextState(State *state, Actions action);
-        std::tuple<State*, double> getStateTransitionResult(State *s, Actions a);
+        const Transition* getTransitions(int stateIndex, Actions action);
+        const int* getPredecessors(int stateIndex, int *count);
+        int getNextState(int stateIndex, Actions action);
+        std::tuple<int, double> getStateTransitionResult(int stateIndex, Actions a);
         std::string getMazeIdentifier();
         int getMazeWidth();
         int getMazeHeight();
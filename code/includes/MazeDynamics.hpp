@@ -0,0 +1,22 @@
+#ifndef MAZE_DYNAMICS_HPP
+#define MAZE_DYNAMICS_HPP
+
+#include <cstdint>
+
+class MazeDynamics {
+    private:
+        static constexpr uint64_t GATE_SWITCH = 1;
+        uint64_t switches;
+
+    public:
+        MazeDynamics();
+        explicit MazeDynamics(uint64_t switches);
+        void reset();
+        bool gatesAreOpen() const;
+        void openGates();
+        bool snackIsEaten(int snackNumber) const;
+        void eatSnack(int snackNumber);
+        uint64_t getSwitches() const;
+};
+
+#endif
\ No newline at end of file
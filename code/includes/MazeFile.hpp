@@ -0,0 +1,60 @@
+#ifndef MAZE_FILE_HPP
+#define MAZE_FILE_HPP
+
+#include <string>
+#include <tuple>
+#include <cstdint>
+#include <cstddef>
+
+class MazeFile {
+    public:
+        static constexpr uint32_t VERSION = 1;
+        static constexpr const char *EXTENSION = ".mzb";
+        enum SpecialStates {Starting, Gates, Goals, Snacks};
+        static constexpr int SPECIAL_STATE_LISTS = 4;
+        /**
+         * The fixed-size start of a binary maze file.
+         *
+         * It is followed by one byte per tile (its State::Types), padded to a
+         * multiple of four bytes, and then by the special states' indices, one
+         * list after another, as 32-bit integers. All is in native byte order.
+         */
+        struct Header {
+            char magic[8];
+            uint32_t version;
+            int32_t width;
+            int32_t height;
+            uint32_t specialStateNumbers[SPECIAL_STATE_LISTS];
+            uint32_t reserved;
+            double moveProbabilities[4];
+        };
+
+    private:
+        static const char MAGIC[8];
+        void *mapping;
+        size_t length;
+        const Header *header;
+        const unsigned char *types;
+        const int32_t *specialStates[SPECIAL_STATE_LISTS];
+        static size_t typesLength(int tileNumber);
+        bool validate(const std::string& path);
+        void close();
+
+    public:
+        MazeFile();
+        ~MazeFile();
+        MazeFile(const MazeFile&) = delete;
+        MazeFile& operator=(const MazeFile&) = delete;
+        static bool isBinary(const std::string& path);
+        bool open(const std::string& path);
+        int getMazeWidth() const;
+        int getMazeHeight() const;
+        std::tuple<double, double, double, double> getMoveProbabilities() const;
+        const unsigned char* getTypes() const;
+        const int32_t* getSpecialStates(SpecialStates list, int *count) const;
+        static bool write(const std::string& path, int width, int height, const unsigned char *types,
+                std::tuple<double, double, double, double> moveProbabilities);
+        static bool convert(const std::string& inputFile, const std::string& outputFile);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#ifndef MAZE_GENERATOR_HPP
+#define MAZE_GENERATOR_HPP
+
+#include <vector>
+#include <string>
+#include <random>
+#include <cstdint>
+
+class MazeGenerator {
+    public:
+        enum Algorithms {RecursiveBacktracker, Prim, RoomsAndCorridors};
+        static constexpr int MINIMUM_CELLS = 9;
+        static constexpr int MAXIMUM_CELLS = 10000000;
+        static constexpr const char *SPECIFICATION_PREFIX = "generate:";
+
+    private:
+        static constexpr int ROOM_SIDE_MINIMUM = 2;
+        static constexpr int ROOM_SIDE_MAXIMUM = 6;
+        static constexpr int CELLS_PER_ROOM = 40;
+        Algorithms algorithm;
+        int width;
+        int height;
+        uint64_t seed;
+        double pitDensity;
+        double warpDensity;
+        double leverDensity;
+        double gateDensity;
+        double snackDensity;
+        std::mt19937_64 engine;
+        std::vector<char> tiles;
+        int startTile;
+        int goalTile;
+        static bool algorithmFromName(const std::string &name, Algorithms *algorithm);
+        bool densityFromField(const std::string &field);
+        int randomBelow(int ceiling);
+        int cellColumns() const;
+        int cellRows() const;
+        int tileOfCell(int cell) const;
+        int neighbouringCell(int cell, int direction) const;
+        void connectCells(int cell, int neighbour);
+        void carveRecursiveBacktracker();
+        void carvePrim();
+        int findSet(std::vector<int> *sets, int cell);
+        void carveRoomsAndCorridors();
+        std::vector<int> tileDistances(int source, bool stopAtGates) const;
+        std::vector<char> solutionPath(const std::vector<int> &distances) const;
+        std::vector<int> tilesOfType(char tile, const std::vector<char> *exclusions = nullptr) const;
+        std::vector<int> sampleTiles(std::vector<int> candidates, int number);
+        static int tileNumberOfDensity(double density, int openTileNumber, int candidateNumber);
+        void placeTiles(const std::vector<int> &candidates, int number, char tile);
+        void placeSpecialTiles();
+
+    public:
+        MazeGenerator(Algorithms algorithm = RecursiveBacktracker, int cells = MINIMUM_CELLS, uint64_t seed = 0);
+        static bool isSpecification(const std::string &identifier);
+        static bool fromSpecification(const std::string &specification, MazeGenerator *generator);
+        void setDensities(double pits, double warps, double levers, double gates, double snacks);
+        void generate();
+        int getMazeWidth() const;
+        int getMazeHeight() const;
+        char getTile(int x, int y) const;
+        bool writeMaze(const std::string &outputFile) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef MAZE_LAYOUT_HPP
+#define MAZE_LAYOUT_HPP
+
+#include <vector>
+#include <tuple>
+#include <string>
+#include "State.hpp"
+#include "AliasTable.hpp"
+#include "MazeFile.hpp"
+
+class MazeLayout {
+    public:
+        static constexpr int MAXIMUM_SNACKS = 63;
+        struct Transition {
+            int nextIndex;
+            double probability;
+            double reward;
+        };
+
+    private:
+        std::tuple<double, double, double, double> moveProbabilities;
+        int width;
+        int height;
+        const std::string mazeIdentifier;
+        std::vector<unsigned char> ownedStateTypes;
+        const unsigned char *stateTypes;
+        MazeFile *file;
+        std::vector<int> cellsOfStates;
+        std::vector<int> statesOfCells;
+        std::vector<int> startingStates;
+        std::vector<int> gateStates;
+        std::vector<int> goalStates;
+        std::vector<int> snackStates;
+        std::vector<int> nontrivialStates[2];
+        std::vector<Transition> transitions[2];
+        std::vector<int> predecessorOffsets[2];
+        std::vector<int> predecessors[2];
+        AliasTable rotationTable;
+        static double rewardOfType(State::Types type);
+        void getMazeDimensionsFromInput();
+        void getMazeDimensionsFromFile(std::ifstream *inputStream);
+        void addCell(State::Types type);
+        void getMazeStatesFromInput();
+        void getMazeStatesFromFile(std::ifstream *inputStream);
+        void getMazeFromGenerator(const std::string& specification);
+        void getMazeFromBinaryFile(const std::string& inputFile);
+        bool cellIsPassable(int x, int y, bool gatesOpen) const;
+        std::vector<int> markReachableCells(const std::vector<int>& seeds, bool gatesOpen,
+                std::vector<char> *reached) const;
+        void buildStateIndex();
+        void getMazeSpecialStates();
+        void getMazeSpecialStatesFromBinaryFile();
+        void buildNontrivialStates(bool gatesOpen);
+        void buildRotationTable();
+        bool moveIsOutOfBounds(int x, int y) const;
+        void computeTransitions(int stateIndex, bool gatesOpen);
+        void buildTransitionTable(bool gatesOpen);
+        void buildPredecessorIndex(bool gatesOpen);
+
+    public:
+        static State::Types typeFromInput(char input);
+        static std::tuple<double, double, double, double> defaultMoveProbabilities();
+        explicit MazeLayout(std::tuple<double, double, double, double> mps, const std::string& inputFile = "");
+        explicit MazeLayout(const std::string& inputFile = "");
+        ~MazeLayout();
+        MazeLayout(const MazeLayout&) = delete;
+        MazeLayout& operator=(const MazeLayout&) = delete;
+        int indexFromCoordinates(int x, int y) const;
+        int getStateNumber() const;
+        int getCellNumber() const;
+        int getCellOfState(int stateIndex) const;
+        int getStateOfCell(int cellIndex) const;
+        int getStateX(int stateIndex) const;
+        int getStateY(int stateIndex) const;
+        State::Types getStateType(int stateIndex) const;
+        bool stateIsTerminal(int stateIndex) const;
+        bool stateIsIntraversible(int stateIndex, bool gatesOpen) const;
+        int getSnackNumber(int stateIndex) const;
+        int getSnackNumberTotal() const;
+        bool isStatic() const;
+        const std::vector<int>& getStartingStates() const;
+        const std::vector<int>& getGoalStates() const;
+        const std::vector<int>& getNontrivialStates(bool gatesOpen) const;
+        double getActionProbability(int relativeIndex) const;
+        int sampleRotation() const;
+        int sampleRotation(double value) const;
+        const Transition* getTransitions(int stateIndex, int action, bool gatesOpen) const;
+        const int* getPredecessors(int stateIndex, bool gatesOpen, int *count) const;
+        std::string getMazeIdentifier() const;
+        int getMazeWidth() const;
+        int getMazeHeight() const;
+};
+
+#endif
\ No newline at end of file
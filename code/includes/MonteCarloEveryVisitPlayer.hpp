@@ -10,16 +10,16 @@ class MonteCarloEveryVisitPlayer : public MonteCarloPlayer {
         double temperature;
         double G;
         double W;
-        std::map<std::tuple<State*, Maze::Actions>, double> C;
-        std::map<State*, std::vector<double>> explorationPolicy;
+        std::vector<double> C;
+        std::vector<double> explorationPolicy;
         void initialiseC();
         static std::vector<double> stateExplorationPolicy();
         void initialiseExplorationPolicy();
-        void updateExplorationPolicy(State *s, Maze::Actions greedyAction);
-        double actionProbability(State *s, Maze::Actions a) override;
-        std::tuple<State*, Maze::Actions> initialStateActionPair() override;
-        std::tuple<State*, Maze::Actions> nextStateActionPair(std::tuple<State*, Maze::Actions> currentPair) override;
-        void generateEpisode(std::tuple<State*, Maze::Actions> startStateActionPair) override;
+        void updateExplorationPolicy(int s, Maze::Actions greedyAction);
+        double actionProbability(int s, Maze::Actions a) override;
+        std::tuple<int, Maze::Actions> initialStateActionPair() override;
+        std::tuple<int, Maze::Actions> nextStateActionPair(std::tuple<int, Maze::Actions> currentPair) override;
+        void generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) override;
         void performInitialisation() override;
         void performIteration() override;
 
@@ -5,16 +5,12 @@
 
 class MonteCarloExploringStartsPlayer : public MonteCarloPlayer {
     private:
-        std::map<std::tuple<State*, Maze::Actions>, std::vector<double>> returns;
-        State *randomState();
+        int randomState();
         static Maze::Actions randomAction();
-        std::tuple<State*, Maze::Actions> randomStateActionPair();
-        std::tuple<State*, Maze::Actions> initialStateActionPair() override;
-        std::tuple<State*, Maze::Actions> nextStateActionPair(std::tuple<State*, Maze::Actions> currentPair) override;
-        void generateEpisode(std::tuple<State*, Maze::Actions> startStateActionPair) override;
-        double episodeReturnComponent(int k, int rewardIndex);
-        double episodeReturn(int onsetIndex);
-        double returnsAverage(std::tuple<State*, Maze::Actions> stateActionPair);
+        std::tuple<int, Maze::Actions> randomStateActionPair();
+        std::tuple<int, Maze::Actions> initialStateActionPair() override;
+        std::tuple<int, Maze::Actions> nextStateActionPair(std::tuple<int, Maze::Actions> currentPair) override;
+        void generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) override;
         void performInitialisation() override;
         void performIteration() override;
 
@@ -6,14 +6,10 @@
 class MonteCarloFirstVisitPlayer : public MonteCarloPlayer {
     private:
         double epsilon;
-        std::map<std::tuple<State*, Maze::Actions>, std::vector<double>> returns;
-        std::tuple<State*, Maze::Actions> initialStateActionPair() override;
-        std::tuple<State*, Maze::Actions> nextStateActionPair(std::tuple<State*, Maze::Actions> currentPair) override;
-        void generateEpisode(std::tuple<State*, Maze::Actions> startStateActionPair) override;
-        double episodeReturnComponent(int k, int rewardIndex);
-        double episodeReturn(int onsetIndex);
-        double returnsAverage(std::tuple<State*, Maze::Actions> stateActionPair);
-        void updateStatePolicy(State *s, Maze::Actions greedyAction);
+        std::tuple<int, Maze::Actions> initialStateActionPair() override;
+        std::tuple<int, Maze::Actions> nextStateActionPair(std::tuple<int, Maze::Actions> currentPair) override;
+        void generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) override;
+        void updateStatePolicy(int s, Maze::Actions greedyAction);
         void performInitialisation() override;
         void performIteration() override;
 
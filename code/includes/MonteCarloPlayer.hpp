@@ -5,7 +5,13 @@
 
 class MonteCarloPlayer : public LearningPlayer {
     protected:
-        std::vector<std::tuple<State*, Maze::Actions>> episode;
+        std::vector<std::tuple<int, Maze::Actions>> episode;
+        std::vector<int> returnCounts;
+        std::vector<int> visitStamps;
+        std::vector<int> firstVisitIndices;
+        int currentVisitStamp;
+        void addReturn(std::tuple<int, Maze::Actions> stateActionPair, double sampleReturn);
+        void addFirstVisitReturns();
         virtual void performInitialisation() = 0;
         virtual void performIteration() = 0;
 
@@ -9,6 +9,7 @@
 #include <chrono>
 #include "State.hpp"
 #include "Maze.hpp"
+#include "AliasTable.hpp"
 
 class Player {
     public:
@@ -24,26 +25,40 @@ class Player {
         int currentEpoch;
         int timeoutEpoch;
         double discountFactor;
-        std::map<State*, double> stateValues;
-        std::map<State*, std::vector<double>> policy;
+        std::vector<double> stateValues;
+        std::vector<double> policy;
+        std::vector<int> greedyActions;
+        double implicitEpsilon;
+        AliasTable actionTable;
+        std::vector<char> actionTableIsCurrent;
         std::vector<double> epochTimings;
         static std::vector<double> randomDiscretePolicy();
         static std::vector<double> randomStochasticPolicy();
         static std::vector<double> randomStatePolicy(bool stochastic);
         void initialisePolicy(bool stochastic);
+        void initialisePolicy(bool stochastic, int stateNumber);
         void initialiseStateValues();
-        virtual double actionProbability(State *s, Maze::Actions a);
+        void setStatePolicy(int s, const std::vector<double> &statePolicy);
+        void setStatePolicy(int s, Maze::Actions greedyAction, double epsilon = 0.0);
+        void useImplicitPolicy(double epsilon);
+        void setGreedyAction(int s, Maze::Actions greedyAction);
+        void invalidateActionTable(int s);
+        double policyProbability(int s, Maze::Actions a);
+        Maze::Actions policyAction(int s);
+        virtual double actionProbability(int s, Maze::Actions a);
+        virtual int representativeState(int position);
         static std::vector<double> actionAsActionProbabilityDistribution(Maze::Actions a);
         bool maximumIterationReached();
 
     public:
         Maze* maze;
         Player(Maze* m, double gamma = 0.0, bool initialiseStochastic = false);
+        Player(Maze* m, std::vector<double> policy, double gamma = 0.0);
         virtual ~Player();
-        virtual Maze::Actions chooseAction(State *s);
+        virtual Maze::Actions chooseAction(int s);
         virtual void solveMaze() = 0;
         std::vector<double> getEpochTimings();
-        std::map<std::tuple<int, int, Maze::Actions>, double> getPolicy();
+        std::vector<double> getPolicy();
         virtual std::vector<double> getTotalRewardPerEpisode();
         static std::string playerTypeAsStringShortened(Player::Types type);
 };
@@ -6,9 +6,9 @@
 class PolicyIterationPlayer : public DynamicProgrammingPlayer {
     protected:
         bool policyIsStable;
-        double stateValue(State *s, Maze::Actions a);
-        double updatedStateValue(State *s, Maze::Actions a);
-        Maze::Actions greedyActionForState(State *s);
+        double stateValue(int s, Maze::Actions a);
+        double updatedStateValue(int s, Maze::Actions a);
+        Maze::Actions greedyActionForState(int s);
         virtual void performEvaluationStep() = 0;
         virtual void performImprovementStep() = 0;
 
@@ -6,17 +6,16 @@
 class QLearningPlayer : public TimeDifferencePlayer {
     private:
         void performIteration();
-        void generateEpisode(std::tuple<State *, Maze::Actions> startStateActionPair) override;
-        void updateStateActionValue(std::tuple<State*, Maze::Actions> stateActionPair, std::tuple<State*,
-                Maze::Actions> nextStateActionPair);
-        std::tuple<State*, Maze::Actions> initialStateActionPair() override;
-        std::tuple<State*, Maze::Actions> nextStateActionPair(std::tuple<State*, Maze::Actions> currentPair) override;
+        void generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) override;
+        void learnFromStep(int s, Maze::Actions a, double reward, int next, Maze::Actions nextAction) override;
+        std::tuple<int, Maze::Actions> initialStateActionPair() override;
+        std::tuple<int, Maze::Actions> nextStateActionPair(std::tuple<int, Maze::Actions> currentPair) override;
         void updatePolicyUsingStateActionValues();
-        void updatePolicyUsingStateActionValues(State *state);
+        void updatePolicyUsingStateActionValues(int state);
 
 
     public:
-        QLearningPlayer(Maze *m, double gamma, int T, double alpha, double epsilon);
+        QLearningPlayer(Maze *m, double gamma, int T, double alpha, double epsilon, int lanes = 1);
         ~QLearningPlayer();
         void solveMaze() override;
 };
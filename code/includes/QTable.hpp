@@ -0,0 +1,31 @@
+#ifndef Q_TABLE_HPP
+#define Q_TABLE_HPP
+
+#include <vector>
+#include "Maze.hpp"
+
+class QTable {
+    public:
+        static constexpr int ALIGNMENT = 32;
+
+    private:
+        int stateNumber;
+        double *values;
+        void allocate(int states);
+        void release();
+
+    public:
+        explicit QTable(int states = 0, double initialValue = 0.0);
+        QTable(const QTable &other);
+        QTable& operator=(const QTable &other);
+        ~QTable();
+        void assign(int states, double value);
+        double& operator[](int stateActionIndex);
+        const double* getStateValues(int s) const;
+        int getStateNumber() const;
+        double maximumValue(int s) const;
+        Maze::Actions greedyAction(int s) const;
+        void greedyActions(std::vector<int> *out) const;
+};
+
+#endif
\ No newline at end of file
@@ -1,18 +1,48 @@
 #ifndef RANDOM_SERVICES_HPP
 #define RANDOM_SERVICES_HPP
 
+#include <cstdint>
 #include <limits>
 
 class RandomServices {
+    public:
+        /**
+         * The position within one of the generator's streams.
+         *
+         * Each thread draws from a stream of its own, so streams never have to
+         * be shared. A stream is identified by its run, player and worker
+         * numbers; its numbers only depend on those and the master seed.
+         */
+        struct Stream {
+            uint32_t identifier[3];
+            uint32_t block;
+            uint32_t output[4];
+            int outputIndex;
+            double spareNormal;
+            bool hasSpareNormal;
+        };
+        constexpr static uint32_t MAIN_RUN = std::numeric_limits<uint32_t>::max();
+
     private:
         constexpr static double epsilon = std::numeric_limits<double>::min();
         constexpr static double twoPi = 2.0 * 3.14159265358979323846;
-        static void seed();
-        static void initialiseNormalNumberGenerator();
+        constexpr static int PHILOX_ROUNDS = 10;
+        constexpr static int BULK_BLOCKS = 16;
+        static uint64_t masterSeed;
+        static void seed(uint64_t masterSeed);
+        static void generateBlocks(Stream *stream, int blockNumber, uint32_t *words);
+        static void generateBlock(Stream *stream);
+        static double valueFromWords(uint32_t first, uint32_t second);
+        static uint32_t randomWord();
 
     public:
-        static void initialiseRandomServices();
+        static void initialiseRandomServices(uint64_t masterSeed);
+        static uint64_t getMasterSeed();
+        static void selectStream(uint32_t run, uint32_t player, uint32_t worker = 0);
+        static Stream getStream();
+        static void setStream(const Stream& stream);
         static double randomValue();
+        static void randomValues(double *values, int number);
         static double normalSample(double mean, double standardDeviation);
         static bool bernoulliSample(double p);
         static int discreteUniformSample(int ceiling);
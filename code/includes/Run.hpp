@@ -13,29 +13,33 @@
 #include "SarsaPlayer.hpp"
 #include "QLearningPlayer.hpp"
 #include "Datum.hpp"
-
-/* Todo: Make maze state separate for all algorithms. */
+#include "Configuration.hpp"
 
 class Run {
     private:
         int id;
+        Configuration configuration;
         std::vector<Maze*> mazes;
         std::vector<Player::Types> playerSelection;
         std::vector<Player*> players;
         Datum results;
-        void buildMazes(const std::string& mazeIdentifier);
+        void buildMazes(const std::shared_ptr<const MazeLayout>& layout);
         std::map<Player::Types, std::vector<double>> prepareTimings();
-        std::map<Player::Types, std::map<std::tuple<int, int, Maze::Actions>, double>> preparePolicies();
+        std::map<Player::Types, std::vector<double>> preparePolicies();
         std::map<Player::Types, std::vector<double>> prepareAverageRewards();
         void allocatePlayer(int playerIndex, Player::Types type);
-        void allocatePlayers();
-        void runAlgorithms();
         Datum datumFromRun();
         void deallocatePlayers();
 
     public:
-        Run(int id, std::string mazeIdentifier, std::vector<Player::Types> playerSelection);
+        Run(int id, const std::string& mazeIdentifier, std::vector<Player::Types> playerSelection,
+                Configuration configuration = Configuration());
+        Run(int id, const std::shared_ptr<const MazeLayout>& layout, std::vector<Player::Types> playerSelection,
+                Configuration configuration = Configuration());
         ~Run();
+        int getPlayerNumber();
+        void conductPlayer(int playerIndex);
+        Datum collectResults();
         Datum conductRun();
 };
 
@@ -7,14 +7,15 @@ class SarsaPlayer : public TimeDifferencePlayer {
     private:
         void performIteration();
         void updatePolicyUsingQuality();
-        void updatePolicyUsingQuality(State *s);
-        std::tuple<State*, Maze::Actions> initialStateActionPair() override;
-        std::tuple<State*, Maze::Actions> nextStateActionPair(std::tuple<State*, Maze::Actions> currentPair) override;
-        void generateEpisode(std::tuple<State*, Maze::Actions> startStateActionPair) override;
-        Maze::Actions greedyAction(State *s) override;
+        void updatePolicyUsingQuality(int s);
+        std::tuple<int, Maze::Actions> initialStateActionPair() override;
+        std::tuple<int, Maze::Actions> nextStateActionPair(std::tuple<int, Maze::Actions> currentPair) override;
+        void generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) override;
+        void learnFromStep(int s, Maze::Actions a, double reward, int next, Maze::Actions nextAction) override;
+        Maze::Actions greedyAction(int s) override;
 
     public:
-        SarsaPlayer(Maze *m, double gamma, int T, double alpha, double epsilon);
+        SarsaPlayer(Maze *m, double gamma, int T, double alpha, double epsilon, int lanes = 1);
         ~SarsaPlayer() override;
 
         void solveMaze() override;
@@ -0,0 +1,33 @@
+#ifndef SPARSE_SYSTEM_HPP
+#define SPARSE_SYSTEM_HPP
+
+#include <vector>
+
+class SparseSystem {
+    public:
+        static constexpr double RELATIVE_TOLERANCE = 1e-12;
+        static constexpr int ITERATION_LIMIT = 1000;
+
+    private:
+        int size;
+        std::vector<int> rowOffsets;
+        std::vector<int> columns;
+        std::vector<double> coefficients;
+        std::vector<double> constants;
+        std::vector<int> diagonalEntries;
+        std::vector<double> factors;
+        void multiply(const std::vector<double> &x, std::vector<double> *y);
+        bool factorise();
+        void precondition(const std::vector<double> &r, std::vector<double> *z);
+        static double dot(const std::vector<double> &a, const std::vector<double> &b);
+
+    public:
+        explicit SparseSystem(int size = 0);
+        void clear(int size);
+        void addCoefficient(int column, double coefficient);
+        void finishRow(double constant);
+        int getSize();
+        bool solve(std::vector<double> *x);
+};
+
+#endif
\ No newline at end of file
@@ -16,6 +16,7 @@ class State {
         int getX();
         int getY();
         Types getType();
+        bool isActivated();
         void setActivation(bool activation);
 };
 
@@ -2,14 +2,24 @@
 #define SYNCHRONOUS_POLICY_ITERATION_PLAYER_HPP
 
 #include "PolicyIterationPlayer.hpp"
+#include "SparseSystem.hpp"
 
 class SynchronousPolicyIterationPlayer : public PolicyIterationPlayer {
     private:
+        static constexpr double IMPROVEMENT_TOLERANCE = 1e-9;
+        bool exactEvaluation;
+        std::vector<int> unknownIndices;
+        std::vector<int> unknownStates;
+        std::vector<double> solution;
+        SparseSystem evaluationSystem;
+        void indexUnknownStates();
+        void assembleEvaluationSystem();
+        bool performExactEvaluationStep();
         void performEvaluationStep() override;
         void performImprovementStep() override;
 
     public:
-        SynchronousPolicyIterationPlayer(Maze *m, double gamma, double theta);
+        SynchronousPolicyIterationPlayer(Maze *m, double gamma, double theta, bool exactEvaluation = false);
         ~SynchronousPolicyIterationPlayer() override;
 };
 
@@ -2,14 +2,18 @@
 #define SYNCHRONOUS_VALUE_ITERATION_PLAYER_HPP
 
 #include "ValueIterationPlayer.hpp"
+#include "ThreadPool.hpp"
 
 class SynchronousValueIterationPlayer : public ValueIterationPlayer {
     private:
+        ThreadPool *threadPool;
+        std::vector<double> chunkDeltas;
+        double sweepStates(int begin, int end);
         void performRepetitionStep() override;
         void performConstructionStep() override;
 
     public:
-        SynchronousValueIterationPlayer(Maze *m, double gamma, double theta);
+        SynchronousValueIterationPlayer(Maze *m, double gamma, double theta, int threads = 1);
         ~SynchronousValueIterationPlayer() override;
 };
 
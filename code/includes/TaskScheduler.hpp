@@ -0,0 +1,24 @@
+#ifndef TASK_SCHEDULER_HPP
+#define TASK_SCHEDULER_HPP
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+
+class TaskScheduler {
+    private:
+        int workerNumber;
+        std::vector<std::deque<int>> queues;
+        std::vector<std::mutex> queueLocks;
+        bool takeOwnTask(int worker, int *task);
+        bool stealTask(int worker, int *task);
+        void work(int worker, const std::function<void(int, int)> &body);
+
+    public:
+        explicit TaskScheduler(int workers);
+        int getWorkerNumber();
+        void run(int taskNumber, const std::function<void(int, int)> &body);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+class ThreadPool {
+    private:
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::condition_variable workFinished;
+        std::function<void(int)> task;
+        int taskNumber;
+        int nextTask;
+        int unfinishedTasks;
+        bool stopping;
+        void work();
+        void performTasks(std::unique_lock<std::mutex> *lock);
+
+    public:
+        explicit ThreadPool(int threads);
+        ~ThreadPool();
+        int getThreadNumber();
+        void parallelFor(int begin, int end, const std::function<void(int, int, int)> &body);
+};
+
+#endif
\ No newline at end of file
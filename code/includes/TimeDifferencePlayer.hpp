@@ -2,21 +2,35 @@
 #define TIME_DIFFERENCE_PLAYER_HPP
 
 #include "LearningPlayer.hpp"
+#include "BatchMaze.hpp"
 
 class TimeDifferencePlayer : public LearningPlayer {
     protected:
         static constexpr double INITIAL_QUALITY_VALUE = 0.0;
         double alpha;
         double epsilon;
-        std::map<std::tuple<State*, Maze::Actions>, double> quality;
+        QTable quality;
+        int laneNumber;
+        BatchMaze *batch;
+        std::vector<int> laneStates;
+        std::vector<Maze::Actions> laneActions;
+        std::vector<int> laneNextStates;
+        std::vector<double> laneRewards;
+        std::vector<double> laneRewardTotals;
+        std::vector<int> laneSteps;
+        std::vector<char> laneDone;
+        std::vector<char> laneActive;
+        virtual void learnFromStep(int s, Maze::Actions a, double reward, int next, Maze::Actions nextAction) = 0;
+        void performBatchIteration();
+        void solveMazeInBatches();
 
     public:
-        TimeDifferencePlayer(Maze *m, double gamma, int T, double alpha, double epsilon);
+        TimeDifferencePlayer(Maze *m, double gamma, int T, double alpha, double epsilon, int lanes = 1);
         ~TimeDifferencePlayer() override;
 
     private:
         void initialiseQuality();
-        void setQuality(State *s, Maze::Actions action, double value); 
+        void setQuality(int s, Maze::Actions action, double value);
 };
 
 #endif
\ No newline at end of file
@@ -20,7 +20,7 @@ class UserInput {
         static std::vector<Player::Types> selectedPlayers();
 
     public:
-        static Experiment experimentFromUserInput();
+        static Experiment experimentFromUserInput(Configuration configuration = Configuration());
 };
 
 #endif
\ No newline at end of file
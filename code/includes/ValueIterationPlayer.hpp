@@ -5,9 +5,9 @@
 
 class ValueIterationPlayer : public DynamicProgrammingPlayer {
     protected:
-        double stateActionValue(State *s, Maze::Actions a);
-        double updatedStateValue(State *s);
-        Maze::Actions greedyActionForState(State *s);
+        double stateActionValue(int s, Maze::Actions a);
+        double updatedStateValue(int s);
+        Maze::Actions greedyActionForState(int s);
         virtual void performRepetitionStep() = 0;
         virtual void performConstructionStep() = 0;
 
@@ -0,0 +1,153 @@
+#include <algorithm>
+#include "RandomServices.hpp"
+#include "AliasTable.hpp"
+
+/**
+ * Constructs a table of categorical distributions, all uniform initially.
+ *
+ * @param rows The number of distributions held.
+ * @param outcomes The number of outcomes of each distribution.
+ */
+AliasTable::AliasTable(int rows, int outcomes) {
+    this->assign(rows, outcomes);
+}
+
+/**
+ * Resizes the table, making all of its distributions uniform.
+ *
+ * @param rows The number of distributions held.
+ * @param outcomes The number of outcomes of each distribution.
+ */
+void AliasTable::assign(int rows, int outcomes) {
+    int index;
+    this->rowNumber = rows;
+    this->outcomeNumber = outcomes;
+    this->thresholds.assign(rows * outcomes, 1.0);
+    this->aliases.resize(rows * outcomes);
+    for (index = 0; index < rows * outcomes; index++) {
+        this->aliases[index] = index % outcomes;
+    }
+    this->smallOutcomes.resize(outcomes);
+    this->largeOutcomes.resize(outcomes);
+    this->scaledProbabilities.resize(outcomes);
+}
+
+/**
+ * Overwrites a single distribution of the table.
+ *
+ * This is Vose's construction of Walker's alias method. Each outcome gets a
+ * column whose height is its probability times the number of outcomes; the
+ * excess of tall columns is poured into short ones, so that every column ends
+ * up holding at most two outcomes: its own, and an alias. The probabilities
+ * need not sum to one exactly; they are normalised. Distributions without any
+ * probability mass become uniform, so that every row can always be sampled.
+ *
+ * @param row The index of the distribution to overwrite.
+ * @param probabilities The (relative) probability of each outcome.
+ */
+void AliasTable::setDistribution(int row, const double *probabilities) {
+    int outcome, small, large, smallSize, largeSize;
+    double total;
+    double *thresholds;
+    int *aliases;
+    thresholds = &(this->thresholds[row * this->outcomeNumber]);
+    aliases = &(this->aliases[row * this->outcomeNumber]);
+    total = 0.0;
+    for (outcome = 0; outcome < this->outcomeNumber; outcome++) {
+        total += probabilities[outcome];
+    }
+    if (!(total > 0.0)) {
+        for (outcome = 0; outcome < this->outcomeNumber; outcome++) {
+            thresholds[outcome] = 1.0;
+            aliases[outcome] = outcome;
+        }
+        return;
+    }
+    smallSize = largeSize = 0;
+    for (outcome = 0; outcome < this->outcomeNumber; outcome++) {
+        this->scaledProbabilities[outcome] = probabilities[outcome] * (double)this->outcomeNumber / total;
+        if (this->scaledProbabilities[outcome] < 1.0) {
+            this->smallOutcomes[smallSize++] = outcome;
+        } else {
+            this->largeOutcomes[largeSize++] = outcome;
+        }
+    }
+    while (smallSize > 0 && largeSize > 0) {
+        small = this->smallOutcomes[--smallSize];
+        large = this->largeOutcomes[largeSize - 1];
+        thresholds[small] = this->scaledProbabilities[small];
+        aliases[small] = large;
+        this->scaledProbabilities[large] -= 1.0 - this->scaledProbabilities[small];
+        if (this->scaledProbabilities[large] < 1.0) {
+            largeSize--;
+            this->smallOutcomes[smallSize++] = large;
+        }
+    }
+    /* Whatever remains is (up to rounding) exactly one column tall. */
+    while (largeSize > 0) {
+        large = this->largeOutcomes[--largeSize];
+        thresholds[large] = 1.0;
+        aliases[large] = large;
+    }
+    while (smallSize > 0) {
+        small = this->smallOutcomes[--smallSize];
+        thresholds[small] = 1.0;
+        aliases[small] = small;
+    }
+}
+
+/**
+ * Draws an outcome from one of the table's distributions in constant time.
+ *
+ * @param row The index of the distribution to draw from.
+ * @return The index of the outcome drawn.
+ */
+int AliasTable::sample(int row) const {
+    int column;
+    column = row * this->outcomeNumber + RandomServices::discreteUniformSample(this->outcomeNumber - 1);
+    if (RandomServices::randomValue() < this->thresholds[column]) {
+        return column - row * this->outcomeNumber;
+    }
+    return this->aliases[column];
+}
+
+/**
+ * Draws an outcome from one of the table's distributions, given a single
+ * uniform value drawn beforehand.
+ *
+ * The value's integer part (once scaled by the number of outcomes) picks the
+ * column, and its fractional part decides between the column and its alias.
+ * This lets callers draw the values of many samples at once.
+ *
+ * @param row The index of the distribution to draw from.
+ * @param value A random value between zero (inclusive) and one (exclusive).
+ * @return The index of the outcome drawn.
+ */
+int AliasTable::sample(int row, double value) const {
+    int column;
+    double scaled;
+    scaled = value * this->outcomeNumber;
+    column = std::min((int)scaled, this->outcomeNumber - 1);
+    if (scaled - column < this->thresholds[row * this->outcomeNumber + column]) {
+        return column;
+    }
+    return this->aliases[row * this->outcomeNumber + column];
+}
+
+/**
+ * Obtains the number of distributions held.
+ *
+ * @return The number of rows.
+ */
+int AliasTable::getRowNumber() const {
+    return this->rowNumber;
+}
+
+/**
+ * Obtains the number of outcomes of each distribution.
+ *
+ * @return The number of outcomes.
+ */
+int AliasTable::getOutcomeNumber() const {
+    return this->outcomeNumber;
+}
\ No newline at end of file
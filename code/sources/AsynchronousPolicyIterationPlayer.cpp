@@ -11,9 +11,10 @@
  */
 AsynchronousPolicyIterationPlayer::AsynchronousPolicyIterationPlayer(Maze *m, double gamma, double theta,
         int maximumIteration) : PolicyIterationPlayer(m, gamma, theta) {
-    this->currentState = nullptr;
+    this->currentState = -1;
     this->iteration = 0;
     this->maximumIteration = maximumIteration;
+    this->useInPlaceBackups();
 }
 
 /**
@@ -26,14 +27,13 @@ AsynchronousPolicyIterationPlayer::~AsynchronousPolicyIterationPlayer() = defaul
  */
 void AsynchronousPolicyIterationPlayer::performEvaluationStep() {
     double delta, oldValue;
-    State *s;
+    int s;
     do {
         delta = 0.0;
         s = this->randomNontrivialState();
         oldValue = this->stateValues[s];
         this->stateValues[s] = this->updatedStateValue(s, Maze::actionFromIndex(this->chooseAction(s)));
         delta = std::max(delta, std::fabs(oldValue - this->stateValues[s]));
-        this->copyStateValues(&(this->stateValues), &(this->oldStateValues));
         this->currentState = s;
     } while (delta >= this->theta);
 }
@@ -44,7 +44,7 @@ void AsynchronousPolicyIterationPlayer::performEvaluationStep() {
 void AsynchronousPolicyIterationPlayer::performImprovementStep() {
     Maze::Actions greedy;
     greedy = this->greedyActionForState(this->currentState);
-    this->policy[this->currentState] = Player::actionAsActionProbabilityDistribution(greedy);
+    this->setStatePolicy(this->currentState, greedy);
     if (this->iteration < this->maximumIteration) {
         this->policyIsStable = false;
     }
@@ -7,11 +7,15 @@
  * @param gamma The discount factor to apply to earlier-obtained rewards.
  * @param theta The minimal utility difference to decide to keep iterating.
  * @param maximumIteration The maximum iteration to keep running for.
+ * @param prioritizedSweeping Should backups be ordered by their urgency,
+ *      rather than be spread over the states at random?
  */
 AsynchronousValueIterationPlayer::AsynchronousValueIterationPlayer(Maze *m, double gamma, double theta,
-        int maximumIteration) : ValueIterationPlayer(m, gamma, theta) {
+        int maximumIteration, bool prioritizedSweeping) : ValueIterationPlayer(m, gamma, theta) {
     this->iteration = -1;
     this->maximumIteration = maximumIteration;
+    this->prioritizedSweeping = prioritizedSweeping;
+    this->useInPlaceBackups();
 }
 
 /**
@@ -19,20 +23,79 @@ AsynchronousValueIterationPlayer::AsynchronousValueIterationPlayer(Maze *m, doub
  */
 AsynchronousValueIterationPlayer::~AsynchronousValueIterationPlayer() = default;
 
+/**
+ * Queues a state for a backup if its Bellman residual exceeds theta.
+ *
+ * A state is queued anew whenever its residual grows; outdated entries are
+ * skipped once they surface.
+ *
+ * @param s The index of the state to consider.
+ */
+void AsynchronousValueIterationPlayer::prioritizeState(int s) {
+    double residual;
+    if (!this->space->stateIsNontrivial(s)) {
+        return;
+    }
+    residual = std::fabs(this->updatedStateValue(s) - this->stateValues[s]);
+    if (residual >= this->theta && residual > this->priorities[s]) {
+        this->priorities[s] = residual;
+        this->urgentStates.push(std::make_pair(residual, s));
+    }
+}
+
+/**
+ * Repeatedly backs up the state with the largest Bellman residual.
+ *
+ * After each backup, only the state's predecessors can have had their residual
+ * changed, so only they are reconsidered. Once no state's residual exceeds
+ * theta, the values have converged.
+ */
+void AsynchronousValueIterationPlayer::performPrioritizedSweeping() {
+    int s, nontrivialIndex, predecessorIndex, predecessorNumber;
+    const int *predecessors;
+    std::pair<double, int> entry;
+    this->priorities.assign(this->space->getStateNumber(), 0.0);
+    for (nontrivialIndex = 0; nontrivialIndex < this->space->getNontrivialStateNumber(); nontrivialIndex++) {
+        this->prioritizeState(this->space->getNontrivialState(nontrivialIndex));
+    }
+    while (!this->urgentStates.empty()) {
+        entry = this->urgentStates.top();
+        this->urgentStates.pop();
+        s = entry.second;
+        if (entry.first != this->priorities[s]) {
+            continue;   /* Superseded by a later entry, or already backed up. */
+        }
+        auto startTime = std::chrono::high_resolution_clock::now();
+        this->iteration++;
+        this->priorities[s] = 0.0;
+        this->stateValues[s] = this->updatedStateValue(s);
+        predecessors = this->space->getPredecessors(s, &predecessorNumber);
+        for (predecessorIndex = 0; predecessorIndex < predecessorNumber; predecessorIndex++) {
+            this->prioritizeState(predecessors[predecessorIndex]);
+        }
+        auto endTime = std::chrono::high_resolution_clock::now();
+        this->epochTimings.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count() / 1e3);
+    }
+}
+
 /**
  * Performs the repetition step of the asynchronous policy iteration algorithm.
  */
 void AsynchronousValueIterationPlayer::performRepetitionStep() {
-    double delta;
-    State *s;
+    double delta, oldValue;
+    int s;
+    if (this->prioritizedSweeping) {
+        this->performPrioritizedSweeping();
+        return;
+    }
     do {
         auto startTime = std::chrono::high_resolution_clock::now();
         this->iteration++;
         delta = 0.0;
         s = this->randomNontrivialState();
+        oldValue = this->stateValues[s];
         this->stateValues[s] = this->updatedStateValue(s);
-        delta = std::max(delta, std::fabs(this->oldStateValues[s] - this->stateValues[s]));
-        this->copyStateValues(&(this->stateValues), &(this->oldStateValues));
+        delta = std::max(delta, std::fabs(oldValue - this->stateValues[s]));
         auto endTime = std::chrono::high_resolution_clock::now();
         this->epochTimings.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count() / 1e3);
     } while (this->iteration < this->maximumIteration || delta >= this->theta);
@@ -42,11 +105,8 @@ void AsynchronousValueIterationPlayer::performRepetitionStep() {
  * Performs the building step of the asynchronous policy iteration algorithm.
  */
 void AsynchronousValueIterationPlayer::performConstructionStep() {
-    int stateIndex;
-    State* s;
-    for (stateIndex = 0; stateIndex < (int)this->stateValues.size(); stateIndex++) {
-        s = this->maze->getState(stateIndex);
-        this->policy[s] = Player::actionAsActionProbabilityDistribution(
-            this->greedyActionForState(s));
+    int s;
+    for (s = 0; s < this->space->getStateNumber(); s++) {
+        this->setStatePolicy(s, this->greedyActionForState(s));
     }
 }
\ No newline at end of file
@@ -0,0 +1,411 @@
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include "RandomServices.hpp"
+#include "AugmentedStateSpace.hpp"
+
+/**
+ * Obtains the layer of the given switches, creating it on first sight.
+ *
+ * A layer holds one augmented state per position of the layout; state
+ * (layer, position) has index layer * positions + position.
+ *
+ * @param switches The switch bitmask, as used by MazeDynamics.
+ * @return The index of the layer.
+ */
+int AugmentedStateSpace::layerOf(uint64_t switches) {
+    std::unordered_map<uint64_t, int>::const_iterator found;
+    found = this->layerIndices.find(switches);
+    if (found != this->layerIndices.end()) {
+        return found->second;
+    }
+    if ((long long)(this->layerSwitches.size() + 1) * this->positionNumber > INT_MAX) {
+        printf("[AugmentedStateSpace] Error: Too many reachable switch combinations. Aborting.\n");
+        exit(EXIT_FAILURE);
+    }
+    this->layerIndices[switches] = (int)this->layerSwitches.size();
+    this->layerSwitches.push_back(switches);
+    this->reachable.resize(this->layerSwitches.size() * this->positionNumber, 0);
+    return (int)this->layerSwitches.size() - 1;
+}
+
+/**
+ * Computes the switches that hold once a position has been visited.
+ *
+ * A lever opens the gates, and a snack gets eaten.
+ *
+ * @param switches The switches upon arrival.
+ * @param position The index of the visited position.
+ * @return The switches upon departure.
+ */
+uint64_t AugmentedStateSpace::switchesAfterVisit(uint64_t switches, int position) const {
+    MazeDynamics dynamics(switches);
+    switch (this->layout->getStateType(position)) {
+        case State::Types::lever:
+            dynamics.openGates();
+            break;
+        case State::Types::snack:
+            dynamics.eatSnack(this->layout->getSnackNumber(position));
+            break;
+        default:
+            break;
+    }
+    return dynamics.getSwitches();
+}
+
+/**
+ * Obtains the reward of arriving in a position, given the switches by then.
+ *
+ * @param switches The switches upon arrival.
+ * @param position The index of the position.
+ * @return The associated reward.
+ */
+double AugmentedStateSpace::rewardOfPosition(uint64_t switches, int position) const {
+    MazeDynamics dynamics(switches);
+    switch (this->layout->getStateType(position)) {
+        case State::Types::goal:
+            return Maze::GOAL_REWARD;
+        case State::Types::pit:
+            return Maze::NEGATIVE_REWARD;
+        case State::Types::snack:
+            return (dynamics.snackIsEaten(this->layout->getSnackNumber(position)) ? Maze::NORMAL_REWARD :
+                    Maze::POSITIVE_REWARD);
+        default:
+            return Maze::NORMAL_REWARD;
+    }
+}
+
+/**
+ * Marks an augmented state as reachable, queueing it for exploration.
+ *
+ * @param s The index of the augmented state.
+ * @param frontier The states still to explore.
+ */
+void AugmentedStateSpace::markReachable(int s, std::vector<int> *frontier) {
+    if (!this->reachable[s]) {
+        this->reachable[s] = 1;
+        frontier->push_back(s);
+    }
+}
+
+/**
+ * Discovers the layers, and the states within them, reachable from the start.
+ *
+ * Layers are only created for switch combinations that can actually occur,
+ * which is typically a handful, rather than all of them.
+ */
+void AugmentedStateSpace::exploreLayers() {
+    int s, position, nextLayer, actionIndex, rotationIndex, seedIndex;
+    uint64_t switches;
+    std::vector<int> frontier;
+    const std::vector<int> *seeds;
+    const Maze::Transition *outcomes;
+    this->layerOf(0);
+    seeds = &(this->layout->getStartingStates());
+    if (seeds->empty()) {
+        /* Players may start at any nontrivial position. */
+        seeds = &(this->layout->getNontrivialStates(false));
+    }
+    this->startingStates.assign(seeds->begin(), seeds->end());
+    for (seedIndex = 0; seedIndex < (int)seeds->size(); seedIndex++) {
+        this->markReachable((*seeds)[seedIndex], &frontier);
+    }
+    while (!frontier.empty()) {
+        s = frontier.back();
+        frontier.pop_back();
+        position = s % this->positionNumber;
+        if (this->layout->stateIsTerminal(position)) {
+            continue;
+        }
+        switches = this->switchesAfterVisit(this->layerSwitches[s / this->positionNumber], position);
+        nextLayer = this->layerOf(switches);
+        for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+            outcomes = this->layout->getTransitions(position, actionIndex, MazeDynamics(switches).gatesAreOpen());
+            for (rotationIndex = 0; rotationIndex < Maze::ACTION_NUMBER; rotationIndex++) {
+                if (outcomes[rotationIndex].probability > 0.0) {
+                    this->markReachable(nextLayer * this->positionNumber + outcomes[rotationIndex].nextIndex,
+                            &frontier);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Lays out the transitions, rewards and nontrivial states of all layers.
+ *
+ * Augmented state (layer, position) stands for being in the position, with the
+ * layer's switches holding before the position's own effect. Leaving it thus
+ * applies that effect first: the move is made with the gates as they are after
+ * the visit, and lands in the corresponding layer. Rewards of states are
+ * those of arriving in them, so an uneaten snack still pays off.
+ */
+void AugmentedStateSpace::buildTransitions() {
+    int s, position, stateNumber, nextLayer, actionIndex, rotationIndex, outcomeNumber;
+    uint64_t switches;
+    const Maze::Transition *outcomes;
+    Maze::Transition *augmented;
+    stateNumber = this->getStateNumber();
+    outcomeNumber = Maze::ACTION_NUMBER * Maze::ACTION_NUMBER;
+    this->transitions.resize(stateNumber * outcomeNumber);
+    this->rewards.resize(stateNumber);
+    this->nontrivial.assign(stateNumber, 0);
+    this->nontrivialStates.clear();
+    for (s = 0; s < stateNumber; s++) {
+        position = s % this->positionNumber;
+        this->rewards[s] = this->rewardOfPosition(this->layerSwitches[s / this->positionNumber], position);
+        for (actionIndex = 0; actionIndex < outcomeNumber; actionIndex++) {
+            /* Unreachable states keep still, with probability zero. */
+            augmented = &(this->transitions[s * outcomeNumber + actionIndex]);
+            augmented->nextIndex = s;
+            augmented->probability = 0.0;
+            augmented->reward = 0.0;
+        }
+        if (!this->reachable[s] || this->layout->stateIsTerminal(position)) {
+            continue;
+        }
+        this->nontrivial[s] = 1;
+        this->nontrivialStates.push_back(s);
+        switches = this->switchesAfterVisit(this->layerSwitches[s / this->positionNumber], position);
+        nextLayer = this->layerIndices.at(switches);
+        for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+            outcomes = this->layout->getTransitions(position, actionIndex, MazeDynamics(switches).gatesAreOpen());
+            augmented = &(this->transitions[(s * Maze::ACTION_NUMBER + actionIndex) * Maze::ACTION_NUMBER]);
+            for (rotationIndex = 0; rotationIndex < Maze::ACTION_NUMBER; rotationIndex++) {
+                augmented[rotationIndex].nextIndex = nextLayer * this->positionNumber +
+                        outcomes[rotationIndex].nextIndex;
+                augmented[rotationIndex].probability = outcomes[rotationIndex].probability;
+                augmented[rotationIndex].reward = this->rewardOfPosition(switches, outcomes[rotationIndex].nextIndex);
+            }
+        }
+    }
+}
+
+/**
+ * Builds, per augmented state, the nontrivial states that reach it in a step.
+ *
+ * The index is laid out compressed, as in MazeLayout.
+ */
+void AugmentedStateSpace::buildPredecessorIndex() {
+    int stateIndex, outcomeIndex, nextIndex, stateNumber, outcomeNumber, pass;
+    std::vector<int> lastSeenBy, fill;
+    const Maze::Transition *outcomes;
+    stateNumber = this->getStateNumber();
+    outcomeNumber = Maze::ACTION_NUMBER * Maze::ACTION_NUMBER;
+    this->predecessorOffsets.assign(stateNumber + 1, 0);
+    for (pass = 0; pass < 2; pass++) {
+        /* The first pass counts each distinct successor once; the second fills. */
+        lastSeenBy.assign(stateNumber, -1);
+        if (pass == 1) {
+            for (stateIndex = 0; stateIndex < stateNumber; stateIndex++) {
+                this->predecessorOffsets[stateIndex + 1] += this->predecessorOffsets[stateIndex];
+            }
+            this->predecessors.resize(this->predecessorOffsets[stateNumber]);
+            fill.assign(this->predecessorOffsets.begin(), this->predecessorOffsets.end() - 1);
+        }
+        for (stateIndex = 0; stateIndex < stateNumber; stateIndex++) {
+            outcomes = &(this->transitions[stateIndex * outcomeNumber]);
+            for (outcomeIndex = 0; outcomeIndex < outcomeNumber; outcomeIndex++) {
+                nextIndex = outcomes[outcomeIndex].nextIndex;
+                if (outcomes[outcomeIndex].probability > 0.0 && lastSeenBy[nextIndex] != stateIndex) {
+                    lastSeenBy[nextIndex] = stateIndex;
+                    if (pass == 0) {
+                        this->predecessorOffsets[nextIndex + 1]++;
+                    } else {
+                        this->predecessors[fill[nextIndex]++] = stateIndex;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Picks, per position, the augmented state that speaks for it in policies.
+ *
+ * Policies are reported per position. Each position is represented by the
+ * first layer it is reachable in, which is the one a player (re)visiting it
+ * is most likely to be in; unreachable positions by the first layer.
+ */
+void AugmentedStateSpace::buildRepresentatives() {
+    int position, layer;
+    this->representatives.resize(this->positionNumber);
+    for (position = 0; position < this->positionNumber; position++) {
+        this->representatives[position] = position;
+        for (layer = 0; layer < this->getLayerNumber(); layer++) {
+            if (this->reachable[layer * this->positionNumber + position]) {
+                this->representatives[position] = layer * this->positionNumber + position;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Constructs the augmented state space of a maze layout.
+ *
+ * Dynamic mazes change as they are played: levers open gates and snacks get
+ * eaten. Planning over positions alone ignores this. The augmented space pairs
+ * each position with the switches that hold, which makes the maze a proper
+ * (stationary) MDP. Only switch combinations reachable from the start states
+ * are expanded. Warps are treated as ordinary tiles, as before.
+ *
+ * @param layout The layout to augment. It should outlive the space.
+ */
+AugmentedStateSpace::AugmentedStateSpace(const MazeLayout *layout) {
+    this->layout = layout;
+    this->positionNumber = layout->getStateNumber();
+    this->exploreLayers();
+    this->buildTransitions();
+    this->buildPredecessorIndex();
+    this->buildRepresentatives();
+}
+
+/**
+ * Obtains the number of augmented states, i.e. layers times positions.
+ *
+ * @return The number of augmented states.
+ */
+int AugmentedStateSpace::getStateNumber() const {
+    return (int)this->layerSwitches.size() * this->positionNumber;
+}
+
+/**
+ * Obtains the number of reachable switch combinations.
+ *
+ * @return The number of layers. One for static mazes.
+ */
+int AugmentedStateSpace::getLayerNumber() const {
+    return (int)this->layerSwitches.size();
+}
+
+/**
+ * Obtains the number of positions of the layout, i.e. of states per layer.
+ *
+ * @return The number of positions.
+ */
+int AugmentedStateSpace::getPositionNumber() const {
+    return this->positionNumber;
+}
+
+/**
+ * Obtains the position of an augmented state.
+ *
+ * @param s The index of the augmented state.
+ * @return The index of its position within the layout.
+ */
+int AugmentedStateSpace::positionOfState(int s) const {
+    return s % this->positionNumber;
+}
+
+/**
+ * Determines whether the augmented state's position is a termination state.
+ *
+ * @param s The index of the augmented state.
+ * @return The question's answer.
+ */
+bool AugmentedStateSpace::stateIsTerminal(int s) const {
+    return this->layout->stateIsTerminal(s % this->positionNumber);
+}
+
+/**
+ * Determines whether the augmented state is reachable and not terminal.
+ *
+ * Only these states need backups; all others keep their initial values.
+ *
+ * @param s The index of the augmented state.
+ * @return The question's answer.
+ */
+bool AugmentedStateSpace::stateIsNontrivial(int s) const {
+    return this->nontrivial[s] != 0;
+}
+
+/**
+ * Obtains the reward of arriving in the augmented state.
+ *
+ * @param s The index of the augmented state.
+ * @return The associated reward.
+ */
+double AugmentedStateSpace::getReward(int s) const {
+    return this->rewards[s];
+}
+
+/**
+ * Obtains the outcomes of performing an action in an augmented state.
+ *
+ * As with Maze::getTransitions, there is one outcome per relative rotation;
+ * their indices are augmented ones, and their rewards those of arrival.
+ *
+ * @param s The index of the augmented state.
+ * @param action The action to execute.
+ * @return The action's possible outcomes.
+ */
+const Maze::Transition* AugmentedStateSpace::getTransitions(int s, Maze::Actions action) const {
+    return &(this->transitions[(s * Maze::ACTION_NUMBER + action) * Maze::ACTION_NUMBER]);
+}
+
+/**
+ * Obtains the nontrivial states from which the given state is reached in a step.
+ *
+ * @param s The index of the augmented state.
+ * @param count Output parameter. The number of predecessors.
+ * @return The indices of the predecessors, each listed once.
+ */
+const int* AugmentedStateSpace::getPredecessors(int s, int *count) const {
+    *count = this->predecessorOffsets[s + 1] - this->predecessorOffsets[s];
+    return this->predecessors.data() + this->predecessorOffsets[s];
+}
+
+/**
+ * Obtains the augmented states episodes may start in.
+ *
+ * These all lie in the first layer, in which no switches are set.
+ *
+ * @return The indices of the starting states.
+ */
+const std::vector<int>& AugmentedStateSpace::getStartingStates() const {
+    return this->startingStates;
+}
+
+/**
+ * Obtains the number of nontrivial augmented states.
+ *
+ * @return The number of nontrivial states.
+ */
+int AugmentedStateSpace::getNontrivialStateNumber() const {
+    return (int)this->nontrivialStates.size();
+}
+
+/**
+ * Obtains a nontrivial augmented state by its rank.
+ *
+ * @param index The rank, from zero up to the number of nontrivial states.
+ * @return The index of the augmented state.
+ */
+int AugmentedStateSpace::getNontrivialState(int index) const {
+    return this->nontrivialStates[index];
+}
+
+/**
+ * Obtains an arbitrary nontrivial augmented state.
+ *
+ * @return The index of a random nontrivial state.
+ */
+int AugmentedStateSpace::getRandomNontrivialState() const {
+    if (this->nontrivialStates.empty()) {
+        printf("[AugmentedStateSpace] Error: The maze has no nontrivial states. Aborting.\n");
+        exit(EXIT_FAILURE);
+    }
+    return this->nontrivialStates[RandomServices::discreteUniformSample((int)this->nontrivialStates.size() - 1)];
+}
+
+/**
+ * Obtains the augmented state that represents a position in policies, absent
+ * better knowledge.
+ *
+ * @param position The index of the position.
+ * @return The index of the representing augmented state.
+ */
+int AugmentedStateSpace::representativeState(int position) const {
+    return this->representatives[position];
+}
\ No newline at end of file
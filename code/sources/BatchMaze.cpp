@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <cstdlib>
+#include "RandomServices.hpp"
+#include "BatchMaze.hpp"
+
+/**
+ * Constructs a batch of mazes that are stepped through in lockstep.
+ *
+ * All lanes share the layout, but each keeps the dynamics of its own episode.
+ * A lane's episodes behave exactly as those of a Maze on the same layout; only
+ * the random numbers are drawn for all lanes at once.
+ *
+ * @param layout The layout of the mazes. It should outlive the batch.
+ * @param laneNumber The number of lanes, i.e. of episodes stepped together.
+ */
+BatchMaze::BatchMaze(const MazeLayout *layout, int laneNumber) {
+    this->layout = layout;
+    this->laneNumber = laneNumber;
+    this->dynamics.assign(laneNumber, MazeDynamics());
+    this->rotationValues.resize(laneNumber);
+}
+
+/**
+ * Obtains the number of lanes of the batch.
+ *
+ * @return The number of lanes.
+ */
+int BatchMaze::getLaneNumber() const {
+    return this->laneNumber;
+}
+
+/**
+ * Obtains the layout shared by the lanes.
+ *
+ * @return The layout.
+ */
+const MazeLayout* BatchMaze::getLayout() const {
+    return this->layout;
+}
+
+/**
+ * Starts a new episode in one of the lanes.
+ *
+ * The lane's opened gates and eaten snacks are cleared, and a starting state
+ * is drawn as Maze::getStartingState() would.
+ *
+ * @param lane The index of the lane.
+ * @return The index of the episode's starting state.
+ */
+int BatchMaze::startEpisode(int lane) {
+    const std::vector<int> &startingStates = this->layout->getStartingStates();
+    const std::vector<int> &nontrivialStates = this->layout->getNontrivialStates(false);
+    this->dynamics[lane].reset();
+    if (!startingStates.empty()) {
+        return startingStates[RandomServices::discreteUniformSample((int)startingStates.size() - 1)];
+    }
+    if (nontrivialStates.empty()) {
+        printf("[BatchMaze] Error: The maze has no nontrivial states. Aborting.\n");
+        exit(EXIT_FAILURE);
+    }
+    return nontrivialStates[RandomServices::discreteUniformSample((int)nontrivialStates.size() - 1)];
+}
+
+/**
+ * Computes the state in which a lane arrives after taking a warp.
+ *
+ * @param lane The index of the lane.
+ * @param stateIndex The index of the warp.
+ * @return The index of the resulting state.
+ */
+int BatchMaze::warpResult(int lane, int stateIndex) const {
+    int i, goalIndex, nextIndex;
+    const std::vector<int> &goalStates = this->layout->getGoalStates();
+    goalIndex = goalStates[RandomServices::discreteUniformSample((int)goalStates.size() - 1)];
+    for (i = 0; i < Maze::ACTION_NUMBER; i++) {
+        nextIndex = this->layout->getTransitions(goalIndex, i,
+                this->dynamics[lane].gatesAreOpen())[Maze::Rotations::Zero].nextIndex;
+        if (nextIndex != goalIndex) {
+            return nextIndex;
+        }
+    }
+    /* Theoretically impossible: Warp fails, so act as if it's a normal tile. */
+    return stateIndex;
+}
+
+/**
+ * Performs one action in every lane that has not finished its episode yet.
+ *
+ * All arrays hold one entry per lane. The rotations of all lanes are drawn
+ * together first; then each lane moves, is rewarded for arriving, and has its
+ * arrival's effect applied, as in Maze::getStateTransitionResult().
+ *
+ * @param states The lanes' current states.
+ * @param actions The lanes' chosen actions.
+ * @param nextStates Output parameter. The lanes' resulting states.
+ * @param rewards Output parameter. The lanes' rewards for arriving.
+ * @param done Input/output parameter. Lanes whose flag is set are left alone;
+ *      the flag gets set for lanes that arrive in a terminal state.
+ */
+void BatchMaze::step(const int *states, const Maze::Actions *actions, int *nextStates, double *rewards, char *done) {
+    int lane, next;
+    const Maze::Transition *outcome;
+    MazeDynamics *laneDynamics;
+    RandomServices::randomValues(this->rotationValues.data(), this->laneNumber);
+    for (lane = 0; lane < this->laneNumber; lane++) {
+        if (done[lane]) {
+            continue;
+        }
+        laneDynamics = &(this->dynamics[lane]);
+        outcome = this->layout->getTransitions(states[lane], actions[lane], laneDynamics->gatesAreOpen()) +
+                this->layout->sampleRotation(this->rotationValues[lane]);
+        next = outcome->nextIndex;
+        rewards[lane] = outcome->reward;
+        switch (this->layout->getStateType(next)) {
+            case State::Types::warp:
+                next = this->warpResult(lane, next);
+                break;
+            case State::Types::lever:
+                laneDynamics->openGates();
+                break;
+            case State::Types::snack:
+                if (laneDynamics->snackIsEaten(this->layout->getSnackNumber(next))) {
+                    rewards[lane] = Maze::NORMAL_REWARD;
+                } else {
+                    laneDynamics->eatSnack(this->layout->getSnackNumber(next));
+                }
+                break;
+            default:
+                break;
+        }
+        nextStates[lane] = next;
+        done[lane] = (char)this->layout->stateIsTerminal(next);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <algorithm>
+#include "Configuration.hpp"
+
+/**
+ * Constructs the default configuration, in which everything runs serially.
+ *
+ * The default seed is taken from the clock, so that experiments differ.
+ */
+Configuration::Configuration() {
+    this->sweepThreads = 1;
+    this->jobs = 1;
+    this->lanes = 1;
+    this->prioritizedSweeping = false;
+    this->exactEvaluation = false;
+    this->analyticEvaluation = false;
+    this->seed = (uint64_t)time(nullptr);
+}
+
+/**
+ * Parses a thread number argument.
+ *
+ * @param argument The argument to parse. Zero selects one per hardware thread.
+ * @param threads Output parameter. The number of threads, at least one.
+ * @return Whether the argument was a valid thread number.
+ */
+bool Configuration::threadNumberFromArgument(const char *argument, int *threads) {
+    int value;
+    char *end;
+    value = (int)strtol(argument, &end, 10);
+    if (*end != '\0' || end == argument || value < 0) {
+        printf("[Configuration] Error: Invalid thread number '%s'. Ignoring.\n", argument);
+        return false;
+    }
+    *threads = (value == 0 ? (int)std::thread::hardware_concurrency() : value);
+    *threads = (*threads < 1 ? 1 : *threads);
+    return true;
+}
+
+/**
+ * Parses a lane number argument.
+ *
+ * @param argument The argument to parse.
+ * @param lanes Output parameter. The number of lanes, at least one.
+ * @return Whether the argument was a valid lane number.
+ */
+bool Configuration::laneNumberFromArgument(const char *argument, int *lanes) {
+    int value;
+    char *end;
+    value = (int)strtol(argument, &end, 10);
+    if (*end != '\0' || end == argument || value < 1) {
+        printf("[Configuration] Error: Invalid lane number '%s'. Ignoring.\n", argument);
+        return false;
+    }
+    *lanes = value;
+    return true;
+}
+
+/**
+ * Parses a seed argument.
+ *
+ * @param argument The argument to parse.
+ * @param seed Output parameter. The seed.
+ * @return Whether the argument was a valid seed.
+ */
+bool Configuration::seedFromArgument(const char *argument, uint64_t *seed) {
+    unsigned long long value;
+    char *end;
+    value = strtoull(argument, &end, 10);
+    if (*end != '\0' || end == argument || argument[0] == '-') {
+        printf("[Configuration] Error: Invalid seed '%s'. Ignoring.\n", argument);
+        return false;
+    }
+    *seed = (uint64_t)value;
+    return true;
+}
+
+/**
+ * Builds a configuration from the program's command-line arguments.
+ *
+ * Recognised are:
+ *   --threads N  The number of threads to sweep states with in synchronous
+ *                value iteration. Zero selects one per hardware thread. At
+ *                most the hardware threads divided by the jobs are used.
+ *   --jobs N     The number of runs' players to conduct concurrently. Zero
+ *                selects one per hardware thread.
+ *   --lanes N    The number of episodes SARSA, Q-learning and the evaluation
+ *                of average policies play in lockstep, on a batch of mazes.
+ *                One plays them one at a time.
+ *   --prioritized-sweeping  Order asynchronous value iteration's backups by
+ *                urgency, instead of picking states at random.
+ *   --exact-evaluation  Evaluate synchronous policy iteration's policies by
+ *                solving their linear system, instead of by sweeping.
+ *   --analytic-evaluation  Evaluate average policies on static mazes by their
+ *                expected reward total, instead of by playing episodes.
+ *   --seed N     The master seed of the random number generator. Equal seeds
+ *                give equal experiments, regardless of the number of jobs.
+ *   --generate SPEC FILE  Write the maze generated by the specification SPEC
+ *                to FILE, in the input format, instead of experimenting.
+ *                Files ending in '.mzb' get the binary format.
+ *   --convert IN OUT  Convert the plain text maze IN to the binary maze file
+ *                OUT, instead of experimenting.
+ * Unknown or malformed arguments are reported and ignored.
+ *
+ * @param argc The number (count) of command-line arguments.
+ * @param argv A vector of command-line arguments.
+ * @return The configuration.
+ */
+Configuration Configuration::fromArguments(int argc, char *argv[]) {
+    int argumentIndex;
+    Configuration configuration;
+    for (argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        if (strcmp(argv[argumentIndex], "--threads") == 0 && argumentIndex + 1 < argc) {
+            Configuration::threadNumberFromArgument(argv[++argumentIndex], &(configuration.sweepThreads));
+        } else if (strcmp(argv[argumentIndex], "--jobs") == 0 && argumentIndex + 1 < argc) {
+            Configuration::threadNumberFromArgument(argv[++argumentIndex], &(configuration.jobs));
+        } else if (strcmp(argv[argumentIndex], "--lanes") == 0 && argumentIndex + 1 < argc) {
+            Configuration::laneNumberFromArgument(argv[++argumentIndex], &(configuration.lanes));
+        } else if (strcmp(argv[argumentIndex], "--prioritized-sweeping") == 0) {
+            configuration.prioritizedSweeping = true;
+        } else if (strcmp(argv[argumentIndex], "--exact-evaluation") == 0) {
+            configuration.exactEvaluation = true;
+        } else if (strcmp(argv[argumentIndex], "--analytic-evaluation") == 0) {
+            configuration.analyticEvaluation = true;
+        } else if (strcmp(argv[argumentIndex], "--seed") == 0 && argumentIndex + 1 < argc) {
+            Configuration::seedFromArgument(argv[++argumentIndex], &(configuration.seed));
+        } else if (strcmp(argv[argumentIndex], "--generate") == 0 && argumentIndex + 2 < argc) {
+            configuration.generatorSpecification = argv[++argumentIndex];
+            configuration.generatorOutputFile = argv[++argumentIndex];
+        } else if (strcmp(argv[argumentIndex], "--convert") == 0 && argumentIndex + 2 < argc) {
+            configuration.conversionInputFile = argv[++argumentIndex];
+            configuration.conversionOutputFile = argv[++argumentIndex];
+        } else {
+            printf("[Configuration] Error: Unknown argument '%s'. Ignoring.\n", argv[argumentIndex]);
+        }
+    }
+    return configuration;
+}
+
+/**
+ * Obtains the number of threads to sweep states with.
+ *
+ * Every concurrently conducted player sweeps with threads of its own, so the
+ * number is capped at the player's share of the hardware threads. This keeps
+ * jobs and sweep threads together from oversubscribing the machine.
+ *
+ * @return The number of sweep threads. At least one.
+ */
+int Configuration::getSweepThreads() const {
+    int hardwareThreads, share;
+    hardwareThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    share = std::max(1, hardwareThreads / this->jobs);
+    return std::min(this->sweepThreads, share);
+}
+
+/**
+ * Determines whether asynchronous value iteration uses prioritized sweeping.
+ *
+ * @return The question's answer.
+ */
+bool Configuration::usePrioritizedSweeping() const {
+    return this->prioritizedSweeping;
+}
+
+/**
+ * Determines whether synchronous policy iteration evaluates policies exactly.
+ *
+ * @return The question's answer.
+ */
+bool Configuration::useExactEvaluation() const {
+    return this->exactEvaluation;
+}
+
+/**
+ * Determines whether average policies on static mazes are evaluated analytically.
+ *
+ * @return The question's answer.
+ */
+bool Configuration::useAnalyticEvaluation() const {
+    return this->analyticEvaluation;
+}
+
+/**
+ * Obtains the number of runs' players to conduct concurrently.
+ *
+ * @return The number of jobs. At least one.
+ */
+int Configuration::getJobs() const {
+    return this->jobs;
+}
+
+/**
+ * Obtains the number of episodes to play in lockstep, where supported.
+ *
+ * @return The number of lanes. At least one.
+ */
+int Configuration::getLanes() const {
+    return this->lanes;
+}
+
+/**
+ * Obtains the master seed of the random number generator.
+ *
+ * @return The master seed.
+ */
+uint64_t Configuration::getSeed() const {
+    return this->seed;
+}
+
+/**
+ * Determines whether a generated maze should be written, instead of experimenting.
+ *
+ * @return The question's answer.
+ */
+bool Configuration::writesGeneratedMaze() const {
+    return !this->generatorSpecification.empty();
+}
+
+/**
+ * Obtains the specification of the maze to generate.
+ *
+ * @return The generator specification, or an empty string.
+ */
+const std::string& Configuration::getGeneratorSpecification() const {
+    return this->generatorSpecification;
+}
+
+/**
+ * Obtains the file to write the generated maze to.
+ *
+ * @return The relative path of the output file, or an empty string.
+ */
+const std::string& Configuration::getGeneratorOutputFile() const {
+    return this->generatorOutputFile;
+}
+
+/**
+ * Determines whether a maze should be converted, instead of experimenting.
+ *
+ * @return The question's answer.
+ */
+bool Configuration::convertsMaze() const {
+    return !this->conversionInputFile.empty();
+}
+
+/**
+ * Obtains the plain text maze to convert.
+ *
+ * @return The relative path of the input file, or an empty string.
+ */
+const std::string& Configuration::getConversionInputFile() const {
+    return this->conversionInputFile;
+}
+
+/**
+ * Obtains the binary maze file to convert to.
+ *
+ * @return The relative path of the output file, or an empty string.
+ */
+const std::string& Configuration::getConversionOutputFile() const {
+    return this->conversionOutputFile;
+}
\ No newline at end of file
@@ -9,12 +9,13 @@
  * @param mazeIdentifier The unique identifier of the maze.
  * @param players The player types present within this datum.
  * @param timings A mapping from player types to episode timing data.
- * @param policies A mapping from player types to a final maze policy.
+ * @param policies A mapping from player types to a final maze policy, laid out
+ *      as [cell][action].
  * @param averageRewards A mapping from player types to total reward.
  */
 Datum::Datum(int id, int mazeWidth, int mazeHeight, std::string mazeIdentifier, std::vector<Player::Types> players,
         std::map<Player::Types, std::vector<double>> timings,
-        std::map<Player::Types, std::map<std::tuple<int, int, Maze::Actions>, double>> policies,
+        std::map<Player::Types, std::vector<double>> policies,
         std::map<Player::Types, std::vector<double>> averageRewards) {
     this->id = id;
     this->mazeWidth = mazeWidth;
@@ -89,19 +90,20 @@ std::string Datum::playerTimings() {
  */
 std::string Datum::singlePlayerPolicy(Player::Types type) {
     int xIndex, yIndex, actionIndex;
+    size_t cellOffset;
     std::string playerPolicy;
-    std::tuple<int, int, Maze::Actions> stateActionPair;
+    const std::vector<double> &policy = this->policies[type];
     for (xIndex = 0; xIndex < this->mazeWidth; xIndex++) {
         for (yIndex = 0; yIndex < this->mazeHeight; yIndex++) {
+            cellOffset = ((size_t)yIndex * this->mazeWidth + xIndex) * Maze::ACTION_NUMBER;
             for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-                stateActionPair = std::make_tuple(xIndex, yIndex, (Maze::Actions)actionIndex);
                 playerPolicy.append("\"" + std::to_string(this->id) + "\",");
                 playerPolicy.append("\"" + this->mazeIdentifier + "\",");
                 playerPolicy.append("\"" + Player::playerTypeAsStringShortened(type) + "\",");
                 playerPolicy.append("\"" + std::to_string(xIndex) + "\",");
                 playerPolicy.append("\"" + std::to_string(yIndex) + "\",");
                 playerPolicy.append("\"" + Maze::actionAsString((Maze::Actions)actionIndex) + "\",");
-                playerPolicy.append("\"" + std::to_string(this->policies[type][stateActionPair]) + "\"\n");
+                playerPolicy.append("\"" + std::to_string(cellOffset < policy.size() ? policy[cellOffset + actionIndex] : 0.0) + "\"\n");
             }
         }
     }
@@ -188,12 +190,30 @@ std::string Datum::getMazeIdentifier() {
     return this->mazeIdentifier;
 }
 
+/**
+ * Obtains the width of the maze this datum holds data of.
+ *
+ * @return The maze's width.
+ */
+int Datum::getMazeWidth() {
+    return this->mazeWidth;
+}
+
+/**
+ * Obtains the height of the maze this datum holds data of.
+ *
+ * @return The maze's height.
+ */
+int Datum::getMazeHeight() {
+    return this->mazeHeight;
+}
+
 /**
  * Obtains the policy of the given player type.
  *
  * @param type The player type of which to get the policy.
- * @return The player type's policy.
+ * @return The player type's policy, laid out as [cell][action], owned by the datum.
  */
-std::map<std::tuple<int, int, Maze::Actions>, double> Datum::getPolicy(Player::Types type) {
+const std::vector<double>& Datum::getPolicy(Player::Types type) {
     return this->policies[type];
 }
\ No newline at end of file
@@ -1,9 +1,12 @@
-#include <RandomServices.hpp>
 #include "DynamicProgrammingPlayer.hpp"
 
 /**
  * Constructs a dynamic programming player.
  *
+ * The player plans over the maze's augmented state space, in which states are
+ * positions paired with the maze's switches. Its state values and policy are
+ * laid out accordingly.
+ *
  * @param m The maze the player needs to solve.
  * @param gamma The discount factor for earlier-obtained rewards.
  * @param theta The minimal utility difference to keep iterating.
@@ -12,13 +15,176 @@ DynamicProgrammingPlayer::DynamicProgrammingPlayer(Maze *m, double gamma, double
     this->maze = m;
     this->discountFactor = gamma;
     this->theta = theta;
+    this->inPlaceBackups = false;
+    this->space = new AugmentedStateSpace(m->getLayout());
+    this->initialiseAugmentedStateValues();
+    this->initialisePolicy(false, this->space->getStateNumber());
     this->copyStateValues(&(this->stateValues), &(this->oldStateValues));
 }
 
 /**
  * Destructs the dynamic programming player.
  */
-DynamicProgrammingPlayer::~DynamicProgrammingPlayer() = default;
+DynamicProgrammingPlayer::~DynamicProgrammingPlayer() {
+    delete this->space;
+}
+
+/**
+ * Initialises the valuations of the augmented states.
+ *
+ * Terminal states are valued at their rewards; all others at a constant.
+ */
+void DynamicProgrammingPlayer::initialiseAugmentedStateValues() {
+    int s;
+    this->stateValues.resize(this->space->getStateNumber());
+    for (s = 0; s < this->space->getStateNumber(); s++) {
+        if (this->space->stateIsTerminal(s)) {
+            this->stateValues[s] = this->space->getReward(s);
+        } else {
+            this->stateValues[s] = INITIAL_STATE_VALUE;
+        }
+    }
+}
+
+/**
+ * Obtains how often each augmented state is expected to be visited in an episode.
+ *
+ * Episodes follow the player's current policy from the starting states, and
+ * are cut off as an exploit player's would be. Each step only expands the
+ * states that hold probability mass, in the order they were reached in, which
+ * keeps the sums deterministic. Mass is kept alongside those states, so that
+ * only the visits themselves take space per augmented state.
+ *
+ * Policies that cycle or rarely terminate keep mass around for long. Counting
+ * therefore stops once it has expanded as many states as a few sweeps over
+ * the whole state space back up; visits counted until then are returned.
+ *
+ * @return The expected number of visits per augmented state.
+ */
+std::vector<double> DynamicProgrammingPlayer::stateOccupancies() {
+    int s, next, step, stepNumber, stateIndex, startIndex, actionIndex, rotationIndex;
+    long long expansions, expansionLimit;
+    double probability, outcomeProbability, remainder;
+    const Maze::Transition *outcomes;
+    std::vector<double> occupancies, mass, upcomingMass;
+    std::vector<int> slots, active, upcomingActive;
+    const std::vector<int> &startingStates = this->space->getStartingStates();
+    occupancies.assign(this->space->getStateNumber(), 0.0);
+    /* The position of each upcoming state within the upcoming states, or -1. */
+    slots.assign(this->space->getStateNumber(), -1);
+    for (startIndex = 0; startIndex < (int)startingStates.size(); startIndex++) {
+        s = startingStates[startIndex];
+        if (slots[s] < 0) {
+            slots[s] = (int)active.size();
+            active.push_back(s);
+            mass.push_back(0.0);
+        }
+        mass[slots[s]] += 1.0 / (double)startingStates.size();
+    }
+    for (stateIndex = 0; stateIndex < (int)active.size(); stateIndex++) {
+        slots[active[stateIndex]] = -1;
+    }
+    stepNumber = (int)std::ceil(Player::EPISODE_TIMEOUT_FRACTION * this->maze->getCellNumber());
+    expansions = 0;
+    expansionLimit = (long long)OCCUPANCY_SWEEPS * this->space->getStateNumber();
+    for (step = 0; step <= stepNumber && !active.empty(); step++) {
+        expansions += (long long)active.size();
+        if (expansions > expansionLimit) {
+            break;
+        }
+        remainder = 0.0;
+        upcomingActive.clear();
+        upcomingMass.clear();
+        for (stateIndex = 0; stateIndex < (int)active.size(); stateIndex++) {
+            s = active[stateIndex];
+            occupancies[s] += mass[stateIndex];
+            if (!this->space->stateIsNontrivial(s) || step == stepNumber) {
+                continue;
+            }
+            for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+                probability = mass[stateIndex] * this->policyProbability(s, Maze::actionFromIndex(actionIndex));
+                if (probability == 0.0) {
+                    continue;
+                }
+                outcomes = this->space->getTransitions(s, Maze::actionFromIndex(actionIndex));
+                for (rotationIndex = 0; rotationIndex < Maze::ACTION_NUMBER; rotationIndex++) {
+                    outcomeProbability = probability * outcomes[rotationIndex].probability;
+                    if (outcomeProbability == 0.0) {
+                        continue;
+                    }
+                    next = outcomes[rotationIndex].nextIndex;
+                    if (slots[next] < 0) {
+                        slots[next] = (int)upcomingActive.size();
+                        upcomingActive.push_back(next);
+                        upcomingMass.push_back(0.0);
+                    }
+                    upcomingMass[slots[next]] += outcomeProbability;
+                    remainder += outcomeProbability;
+                }
+            }
+        }
+        for (stateIndex = 0; stateIndex < (int)upcomingActive.size(); stateIndex++) {
+            slots[upcomingActive[stateIndex]] = -1;
+        }
+        active.swap(upcomingActive);
+        mass.swap(upcomingMass);
+        if (remainder < OCCUPANCY_TOLERANCE) {
+            /* (Nearly) all episodes have terminated. */
+            break;
+        }
+    }
+    return occupancies;
+}
+
+/**
+ * Picks, per position, the augmented state to report the policy of.
+ *
+ * Reported policies are per position, whereas the player's differs per
+ * switch setting. Each position is represented by the setting the player
+ * most often visits it in; positions it is not seen to visit fall back to the
+ * first setting they are reachable in. With a single setting, as in static
+ * mazes, every position simply represents itself, and no visits are counted.
+ */
+void DynamicProgrammingPlayer::chooseRepresentatives() {
+    int position, layer, s;
+    double best;
+    std::vector<double> occupancies;
+    this->representatives.resize(this->space->getPositionNumber());
+    if (this->space->getLayerNumber() == 1) {
+        for (position = 0; position < this->space->getPositionNumber(); position++) {
+            this->representatives[position] = this->space->representativeState(position);
+        }
+        return;
+    }
+    occupancies = this->stateOccupancies();
+    for (position = 0; position < this->space->getPositionNumber(); position++) {
+        this->representatives[position] = this->space->representativeState(position);
+        best = 0.0;
+        for (layer = 0; layer < this->space->getLayerNumber(); layer++) {
+            s = layer * this->space->getPositionNumber() + position;
+            if (occupancies[s] > best) {
+                this->representatives[position] = s;
+                best = occupancies[s];
+            }
+        }
+    }
+}
+
+/**
+ * Obtains the augmented state whose policy is reported for a position.
+ *
+ * Representatives are chosen once, on first request, by which time the player
+ * should have solved its maze.
+ *
+ * @param position The index of the position within the maze.
+ * @return The index of the representing augmented state.
+ */
+int DynamicProgrammingPlayer::representativeState(int position) {
+    if (this->representatives.empty()) {
+        this->chooseRepresentatives();
+    }
+    return this->representatives[position];
+}
 
 /**
  * Copies the values of the states to a new, target state-value map.
@@ -26,31 +192,40 @@ DynamicProgrammingPlayer::~DynamicProgrammingPlayer() = default;
  * @param source The state-value mapping from which to copy.
  * @param target The state-value mapping to copy to.
  */
-void DynamicProgrammingPlayer::copyStateValues(std::map<State*, double> *source, std::map<State*, double> *target) {
-    int i;
-    double stateValue;
-    State *s;
-    for (i = 0; i < (int)this->maze->getStates()->size(); i++) {
-        s = this->maze->getState(i);
-        stateValue = source->at(s);
-        (*target)[s] = stateValue;
-    }
+void DynamicProgrammingPlayer::copyStateValues(std::vector<double> *source, std::vector<double> *target) {
+    target->assign(source->begin(), source->end());
+}
+
+/**
+ * Makes backups read from the live state values, rather than from a copy.
+ *
+ * This turns the player's updates into in-place (Gauss-Seidel) ones: each
+ * backup immediately sees the results of earlier ones, and no copy of the
+ * state values needs to be kept in sync.
+ */
+void DynamicProgrammingPlayer::useInPlaceBackups() {
+    this->inPlaceBackups = true;
+    std::vector<double>().swap(this->oldStateValues);
+}
+
+/**
+ * Obtains the value of a state as seen by backups of other states.
+ *
+ * @param s The index of the state.
+ * @return The state's value to back up from.
+ */
+double DynamicProgrammingPlayer::backupValue(int s) {
+    return (this->inPlaceBackups ? this->stateValues[s] : this->oldStateValues[s]);
 }
 
 /**
  * Obtains an arbitrary nontrivial state from the player's set of states.
  *
- * A state is regarded as being 'nontrivial' if it is neither terminal nor
- * intraversible.
+ * A state is regarded as being 'nontrivial' if it is reachable, and neither
+ * terminal nor intraversible.
  *
- * @return A random nontrivial state.
+ * @return The index of a random nontrivial state.
  */
-State* DynamicProgrammingPlayer::randomNontrivialState() {
-    State *s;
-    int randomIndex;
-    do {
-        randomIndex = RandomServices::discreteUniformSample((int)this->maze->getStates()->size() - 1);
-        s = &(this->maze->getStates()->at(randomIndex));
-    } while (Maze::stateIsTerminal(s) || Maze::stateIsIntraversible(s));
-    return s;
+int DynamicProgrammingPlayer::randomNontrivialState() {
+    return this->space->getRandomNontrivialState();
 }
\ No newline at end of file
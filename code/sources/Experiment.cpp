@@ -1,5 +1,7 @@
 #include <RandomServices.hpp>
 #include <ExploitPlayer.hpp>
+#include <algorithm>
+#include <future>
 #include "Experiment.hpp"
 
 /**
@@ -7,10 +9,12 @@
  *
  * @param selectedPlayers The player types to use.
  * @param runNumber The number of runs involved.
+ * @param configuration The configuration to conduct the runs with.
  */
-Experiment::Experiment(std::vector<Player::Types> selectedPlayers, int runNumber) {
+Experiment::Experiment(std::vector<Player::Types> selectedPlayers, int runNumber, Configuration configuration) {
     this->selectedPlayers = std::move(selectedPlayers);
     this->runNumber = runNumber;
+    this->configuration = configuration;
 }
 
 /**
@@ -18,11 +22,14 @@ Experiment::Experiment(std::vector<Player::Types> selectedPlayers, int runNumber
  *
  * @param selectedPlayers The player types to use.
  * @param selectedMazes The maze identifiers of the mazes to use.
+ * @param configuration The configuration to conduct the runs with.
  */
-Experiment::Experiment(std::vector<Player::Types> selectedPlayers, std::vector<std::string> selectedMazes) {
+Experiment::Experiment(std::vector<Player::Types> selectedPlayers, std::vector<std::string> selectedMazes,
+        Configuration configuration) {
     this->selectedPlayers = std::move(selectedPlayers);
     this->selectedMazes   = std::move(selectedMazes);
     this->runNumber = (int)this->selectedMazes.size();
+    this->configuration = configuration;
 }
 
 /**
@@ -66,50 +73,131 @@ void Experiment::clearOldData() {
 }
 
 /**
- * Compute the average policy of some player, in some maze.
+ * Adds the policies of a completed run to the policy sums of its maze.
  *
- * @param mazeIdentifier The identifier of the maze.
- * @param type The player type.
- * @return The average policy.
+ * Sums are kept per maze and player, as a dense array laid out as
+ * [cell][action], like the runs' policies, which are thus added entry by entry.
+ * They are turned into averages once all runs are done.
+ *
+ * @param datum The results of the run.
  */
-std::map<std::tuple<int, int, Maze::Actions>, double> Experiment::averagePolicy(const std::string& mazeIdentifier,
-        Player::Types type) {
-    int datumIndex, count;
-    std::map<std::tuple<int, int, Maze::Actions>, double> policy;
-    std::map<std::tuple<int, int, Maze::Actions>, double> average;
-    count = 0;
-    for (datumIndex = 0; datumIndex < (int)this->data.size(); datumIndex++) {
-        policy = this->data[datumIndex].getPolicy(type);
-        if (this->data[datumIndex].getMazeIdentifier() == mazeIdentifier) {
-            count++;
-            if (average.empty()) {
-                /* Simply copy the policy. */
-                average = policy;
-            } else {
-                /* Add to the probability sum for the state action pairs. */
-                for (auto const& a : average) {
-                    average[a.first] += policy[a.first];
-                }
-            }
+void Experiment::foldPolicies(Datum *datum) {
+    int playerIndex;
+    size_t entry, entryNumber;
+    std::vector<double> *sums;
+    const std::vector<double> *policy;
+    entryNumber = (size_t)datum->getMazeWidth() * datum->getMazeHeight() * Maze::ACTION_NUMBER;
+    for (playerIndex = 0; playerIndex < (int)this->selectedPlayers.size(); playerIndex++) {
+        sums = &(this->averagePolicies[std::make_tuple(datum->getMazeIdentifier(),
+                this->selectedPlayers[playerIndex])]);
+        sums->resize(entryNumber, 0.0);
+        policy = &(datum->getPolicy(this->selectedPlayers[playerIndex]));
+        for (entry = 0; entry < entryNumber && entry < policy->size(); entry++) {
+            (*sums)[entry] += (*policy)[entry];
         }
     }
-    for (auto const& a : average) {
-        /* Correct for the number of times the map was present in the experiment. */
-        average[a.first] /= (double)count;
-    }
-    return average;
+    this->mazeRunNumbers[datum->getMazeIdentifier()]++;
 }
 
 /**
  * Conduct the experiment by running all runs.
+ *
+ * Every player of every run is a separate task, handed to a work-stealing
+ * scheduler. A run is only built once its first task starts, so that only runs
+ * being conducted take up memory. Runs on the same maze share its layout,
+ * which is released once the last of them is collected. Layouts and runs are
+ * built outside of any lock; tasks needing one that is being built wait for it.
+ *
+ * A run's results are collected as soon as its last player is done, and its
+ * policies are added to the policy sums. Results are written to output in run
+ * order, as soon as all earlier runs' are, after which they are discarded;
+ * only the runs' maze identifiers are kept.
  */
 void Experiment::conductRuns() {
-    int runIndex;
+    int runIndex, playerNumber, taskNumber, completedTasks, writtenRuns;
+    std::mutex progressLock, runsLock, resultsLock;
+    std::vector<Run*> runs;
+    std::vector<std::string> identifiers;
+    std::map<std::string, std::shared_future<std::shared_ptr<const MazeLayout>>> layouts;
+    std::map<std::string, int> uncollectedRuns;
+    std::vector<int> remainingPlayers;
+    std::vector<Datum> results;
+    std::vector<char> collected;
+    std::vector<std::once_flag> runCreations((size_t)this->runNumber);
+    TaskScheduler scheduler(this->configuration.getJobs());
     printf("  (2/6) Conducting runs.\n");
+    playerNumber = (int)this->selectedPlayers.size();
+    for (runIndex = 0; runIndex < this->runNumber; runIndex++) {
+        identifiers.push_back(this->runMazeIdentifier(runIndex));
+        uncollectedRuns[identifiers[runIndex]]++;
+        runs.push_back(nullptr);
+        remainingPlayers.push_back(playerNumber);
+        results.emplace_back(runIndex);
+        collected.push_back(0);
+    }
+    taskNumber = this->runNumber * playerNumber;
+    completedTasks = writtenRuns = 0;
+    auto acquireLayout = [&](int run) {
+        bool builds;
+        std::promise<std::shared_ptr<const MazeLayout>> promise;
+        std::shared_future<std::shared_ptr<const MazeLayout>> layout;
+        {
+            std::lock_guard<std::mutex> lock(runsLock);
+            builds = (layouts.find(identifiers[run]) == layouts.end());
+            if (builds) {
+                layouts[identifiers[run]] = promise.get_future().share();
+            }
+            layout = layouts[identifiers[run]];
+        }
+        if (builds) {
+            promise.set_value(std::make_shared<const MazeLayout>(identifiers[run]));
+        }
+        return layout.get();
+    };
+    auto acquireRun = [&](int run) {
+        std::call_once(runCreations[run], [&] {
+            runs[run] = new Run(run, acquireLayout(run), this->selectedPlayers, this->configuration);
+        });
+        return runs[run];
+    };
+    auto collectRun = [&](int run) {
+        results[run] = acquireRun(run)->collectResults();
+        delete runs[run];
+        runs[run] = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(runsLock);
+            if (--uncollectedRuns[identifiers[run]] == 0) {
+                layouts.erase(identifiers[run]);
+            }
+        }
+        std::lock_guard<std::mutex> lock(resultsLock);
+        this->foldPolicies(&(results[run]));
+        collected[run] = 1;
+        while (writtenRuns < this->runNumber && collected[writtenRuns]) {
+            this->runMazeIdentifiers.push_back(results[writtenRuns].getMazeIdentifier());
+            results[writtenRuns].writeDatumToFiles();
+            results[writtenRuns] = Datum(writtenRuns);
+            writtenRuns++;
+        }
+    };
+    scheduler.run(taskNumber, [&](int worker, int task) {
+        bool runIsComplete;
+        int taskRun = task / playerNumber;
+        acquireRun(taskRun)->conductPlayer(task % playerNumber);
+        {
+            std::lock_guard<std::mutex> lock(progressLock);
+            runIsComplete = (--remainingPlayers[taskRun] == 0);
+            Experiment::reportProgress(completedTasks++, taskNumber);
+        }
+        if (runIsComplete) {
+            collectRun(taskRun);
+        }
+    });
     for (runIndex = 0; runIndex < this->runNumber; runIndex++) {
-        Experiment::reportProgress(runIndex, this->runNumber);
-        Run run = Run(runIndex, this->runMazeIdentifier(runIndex), this->selectedPlayers);
-        this->data.push_back(run.conductRun());
+        if (!collected[runIndex]) {
+            /* Runs without players are never completed by a task. */
+            collectRun(runIndex);
+        }
     }
     printf("\n");
 }
@@ -117,13 +205,15 @@ void Experiment::conductRuns() {
 /**
  * Determines whether the given maze identifier is already present.
  *
+ * @param identifiers The maze identifiers to look in.
  * @param mazeIdentifier The maze identifier to check for.
  * @return The question's answer.
  */
-bool Experiment::mazeIdentifierAlreadyPresent(std::string mazeIdentifier) {
+bool Experiment::mazeIdentifierAlreadyPresent(const std::vector<std::string>& identifiers,
+        const std::string& mazeIdentifier) {
     int identifierIndex;
-    for (identifierIndex = 0; identifierIndex < (int)this->mazeIdentifiers.size(); identifierIndex++) {
-        if (this->mazeIdentifiers[identifierIndex] == mazeIdentifier) {
+    for (identifierIndex = 0; identifierIndex < (int)identifiers.size(); identifierIndex++) {
+        if (identifiers[identifierIndex] == mazeIdentifier) {
             return true;
         }
     }
@@ -133,18 +223,16 @@ bool Experiment::mazeIdentifierAlreadyPresent(std::string mazeIdentifier) {
 /**
  * Stringify the maze identifiers.
  *
- * @return The maze identifiers, stringified.
+ * @return The distinct maze identifiers of the runs, in order of appearance.
  */
 std::vector<std::string> Experiment::getMazeIdentifiers() {
-    int datumIndex;
-    std::string current;
+    int runIndex;
     std::vector<std::string> identifiers;
     printf("  (3/6) Assigning maze identifiers.\n");
-    for (datumIndex = 0; datumIndex < (int)this->data.size(); datumIndex++) {
-        Experiment::reportProgress(datumIndex, (int)this->data.size());
-        current = this->data[datumIndex].getMazeIdentifier();
-        if (!this->mazeIdentifierAlreadyPresent(current)) {
-            identifiers.push_back(current);
+    for (runIndex = 0; runIndex < (int)this->runMazeIdentifiers.size(); runIndex++) {
+        Experiment::reportProgress(runIndex, (int)this->runMazeIdentifiers.size());
+        if (!Experiment::mazeIdentifierAlreadyPresent(identifiers, this->runMazeIdentifiers[runIndex])) {
+            identifiers.push_back(this->runMazeIdentifiers[runIndex]);
         }
     }
     printf("\n");
@@ -164,82 +252,143 @@ void Experiment::reportProgress(int current, int maximum) {
 
 /**
  * Computes the average policies of the players on each individual maze.
+ *
+ * The policy sums gathered while conducting the runs are divided by the
+ * number of runs on their maze.
  */
 void Experiment::getAveragePolicies() {
-    int mazeIdentifierIndex, playerTypeIndex;
+    int mazeIdentifierIndex, playerTypeIndex, count;
     std::string mazeIdentifier;
-    Player::Types playerType;
+    std::vector<double> *average;
     printf("  (4/6) Taking the averages of policies.\n");
     for (mazeIdentifierIndex = 0; mazeIdentifierIndex < (int)this->mazeIdentifiers.size(); mazeIdentifierIndex++) {
         Experiment::reportProgress(mazeIdentifierIndex, (int)this->mazeIdentifiers.size());
         mazeIdentifier = this->mazeIdentifiers[mazeIdentifierIndex];
+        count = this->mazeRunNumbers[mazeIdentifier];
         for (playerTypeIndex = 0; playerTypeIndex < (int)this->selectedPlayers.size(); playerTypeIndex++) {
-            playerType = this->selectedPlayers[playerTypeIndex];
-            this->averagePolicies[std::make_tuple(mazeIdentifier, playerType)] = this->averagePolicy(mazeIdentifier,
-                    playerType);
+            average = &(this->averagePolicies[std::make_tuple(mazeIdentifier, this->selectedPlayers[playerTypeIndex])]);
+            for (auto &probability : *average) {
+                /* Correct for the number of times the maze was present in the experiment. */
+                probability /= (double)count;
+            }
         }
     }
     printf("\n");
 }
 
 /**
- * Obtains the policies in converted form, ready for output.
+ * Obtains a player's average policy on a maze as a flat table over its states.
  *
  * @param m The maze to convert a player's policy on it for.
  * @param type The player whose policy to convert.
- * @return The converted policy.s
+ * @return The converted policy, laid out as [state][action].
  */
-std::map<State*, std::vector<double>> Experiment::convertedPolicy(Maze *m, Player::Types type) {
+std::vector<double> Experiment::convertedPolicy(Maze *m, Player::Types type) {
     int stateIndex, actionIndex;
-    State *s;
-    std::map<State*, std::vector<double>> converted;
-    std::tuple<std::string, Player::Types> outerKey;
-    std::tuple<int, int, Maze::Actions> innerKey;
-    for (stateIndex = 0; stateIndex < (int)m->getStates()->size(); stateIndex++) {
-        s = m->getState(stateIndex);
-        std::vector<double> actionProbabilities;
-        for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-            outerKey = std::make_tuple(m->getMazeIdentifier(), type);
-            innerKey = std::make_tuple(s->getX(), s->getY(), (Maze::Actions)actionIndex);
-            actionProbabilities.push_back(this->averagePolicies[outerKey][innerKey]);
+    size_t cellOffset;
+    std::vector<double> converted;
+    std::vector<double> *average;
+    converted.assign((size_t)m->getStateNumber() * Maze::ACTION_NUMBER, 0.0);
+    average = &(this->averagePolicies[std::make_tuple(m->getMazeIdentifier(), type)]);
+    for (stateIndex = 0; stateIndex < m->getStateNumber(); stateIndex++) {
+        cellOffset = (size_t)m->getCellOfState(stateIndex) * Maze::ACTION_NUMBER;
+        for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER && cellOffset < average->size(); actionIndex++) {
+            converted[(size_t)stateIndex * Maze::ACTION_NUMBER + actionIndex] = (*average)[cellOffset + actionIndex];
         }
-        converted[s] = actionProbabilities;
     }
     return converted;
 }
 
 /**
- * Employs exploit players to evaluate a player's policy on a maze.
+ * Employs exploit players to evaluate all players' policies on a maze.
+ *
+ * Each player's evaluation runs are split into slices, such that there are
+ * about as many slices as workers. Every slice is a task, in which a single
+ * exploit player, on a maze of its own, plays the slice's runs. All mazes share
+ * the layout, and all exploit players of a player copy its converted policy.
+ *
+ * Every batch of runs, of as many runs as there are lanes, draws from a random
+ * stream of its own. The rewards thus do not depend on the number of workers.
+ *
+ * With analytic evaluation, policies on static mazes are not played. Each is
+ * given its expected reward total instead, as its single reward, unless that
+ * costs more to compute than the evaluation runs would to play.
  *
  * @param mazeIdentifierIndex The identifier index to the maze to evaluate.
- * @param type The player type to evaluate for.
+ * @param scheduler The scheduler to hand the slices to.
  */
-void Experiment::evaluateAveragePolicy(int mazeIdentifierIndex, Player::Types type) {
-    int evaluationIndex;
+void Experiment::evaluateAveragePolicies(int mazeIdentifierIndex, TaskScheduler *scheduler) {
+    int playerIndex, playerNumber, sliceNumber, lanes;
+    std::vector<char> evaluated;
     std::string mazeIdentifier = this->mazeIdentifiers[mazeIdentifierIndex];
-    Maze maze = Maze(mazeIdentifier);
-    std::vector<double> rewards;
-    std::map<State*, std::vector<double>> m;
-    for (evaluationIndex = 0; evaluationIndex < EVALUATION_RUNS; evaluationIndex++) {
-        m = this->convertedPolicy(&maze, type);
-        ExploitPlayer p = ExploitPlayer(&maze, m);
-        p.solveMaze();
-        rewards.push_back(p.getRewardTotal());
+    std::shared_ptr<const MazeLayout> layout = std::make_shared<const MazeLayout>(mazeIdentifier);
+    Maze maze = Maze(layout);
+    std::vector<std::vector<double>> policies, rewards;
+    playerNumber = (int)this->selectedPlayers.size();
+    for (playerIndex = 0; playerIndex < playerNumber; playerIndex++) {
+        policies.push_back(this->convertedPolicy(&maze, this->selectedPlayers[playerIndex]));
+        rewards.emplace_back((size_t)EVALUATION_RUNS);
+    }
+    evaluated.assign(playerNumber, 0);
+    if (this->configuration.useAnalyticEvaluation() && maze.isStatic()) {
+        scheduler->run(playerNumber, [&](int worker, int task) {
+            double expected;
+            Maze taskMaze = Maze(layout);
+            ExploitPlayer p = ExploitPlayer(&taskMaze, policies[task]);
+            if (p.expectedRewardTotal(EVALUATION_RUNS, &expected)) {
+                rewards[task].assign(1, expected);
+                evaluated[task] = 1;
+            }
+        });
+    }
+    if (std::find(evaluated.begin(), evaluated.end(), 0) != evaluated.end()) {
+        lanes = std::min(this->configuration.getLanes(), (int)EVALUATION_RUNS);
+        sliceNumber = std::max(1, (scheduler->getWorkerNumber() + playerNumber - 1) / std::max(playerNumber, 1));
+        scheduler->run(playerNumber * sliceNumber, [&](int worker, int task) {
+            int taskPlayer, batch, firstBatch, endBatch, evaluationIndex, totalIndex;
+            int batchNumber = (EVALUATION_RUNS + lanes - 1) / lanes;
+            RandomServices::Stream previousStream;
+            std::vector<double> totals;
+            Maze sliceMaze = Maze(layout);
+            taskPlayer = task / sliceNumber;
+            firstBatch = batchNumber * (task % sliceNumber) / sliceNumber;
+            endBatch = batchNumber * (task % sliceNumber + 1) / sliceNumber;
+            if (evaluated[taskPlayer] || firstBatch == endBatch) {
+                return;
+            }
+            ExploitPlayer p = ExploitPlayer(&sliceMaze, policies[taskPlayer], lanes);
+            previousStream = RandomServices::getStream();
+            for (batch = firstBatch; batch < endBatch; batch++) {
+                RandomServices::selectStream(RandomServices::MAIN_RUN,
+                        (uint32_t)(1 + mazeIdentifierIndex * playerNumber + taskPlayer), (uint32_t)batch);
+                p.solveMaze();
+                totals = p.getRewardTotals();
+                for (totalIndex = 0; totalIndex < (int)totals.size(); totalIndex++) {
+                    evaluationIndex = batch * lanes + totalIndex;
+                    if (evaluationIndex < EVALUATION_RUNS) {
+                        rewards[taskPlayer][evaluationIndex] = totals[totalIndex];
+                    }
+                }
+            }
+            RandomServices::setStream(previousStream);
+        });
+    }
+    for (playerIndex = 0; playerIndex < playerNumber; playerIndex++) {
+        this->averagePolicyRewards[std::make_tuple(mazeIdentifier, this->selectedPlayers[playerIndex])] =
+                std::move(rewards[playerIndex]);
     }
-    this->averagePolicyRewards[std::make_tuple(maze.getMazeIdentifier(), type)] = rewards;
 }
 
 /**
  * Employs exploit players to evaluate all player's policies on all mazes.
  */
 void Experiment::evaluateAveragePolicies() {
-    int mazeIdentifierIndex, playerIndex;
+    int mazeIdentifierIndex;
+    TaskScheduler scheduler(this->configuration.getJobs());
     printf("  (5/6) Evaluating average policies.\n");
     for (mazeIdentifierIndex = 0; mazeIdentifierIndex < (int)this->mazeIdentifiers.size(); mazeIdentifierIndex++) {
         Experiment::reportProgress(mazeIdentifierIndex, (int) this->mazeIdentifiers.size());
-        for (playerIndex = 0; playerIndex < (int) this->selectedPlayers.size(); playerIndex++) {
-            this->evaluateAveragePolicy(mazeIdentifierIndex, this->selectedPlayers[playerIndex]);
-        }
+        this->evaluateAveragePolicies(mazeIdentifierIndex, &scheduler);
     }
     printf("\n");
 }
@@ -282,19 +431,14 @@ void Experiment::writeAveragePoliciesRewards() {
 
 /**
  * Writes data of the experiment to "output/data/".
- * 
- * Using the Datum class it writes the data in data[] to the output directory. The timings
- * (how long it takes for a player to complete an epoch) are written to "output/data/timings.csv".
- * The policies of the player for every epoch are written to "output/data/policies.csv".
+ *
+ * The runs' own data, being their timings, policies and rewards per episode,
+ * was written while conducting them. What remains are the rewards of the
+ * average policies, which are written to "output/data/exploitation.csv".
  */
 void Experiment::writeData() {
-    int datumIndex;
     printf("  (6/6) Writing data to output.\n");
-    for (datumIndex = 0; datumIndex < (int)this->data.size(); datumIndex++) {
-        Experiment::reportProgress(datumIndex, (int)this->data.size());
-        this->data[datumIndex].writeDatumToFiles();
-    }
-    printf("\n");
+    this->writeAveragePoliciesRewards();
 }
 
 /**
@@ -306,13 +450,12 @@ void Experiment::writeData() {
  * The time it takes for an algorithm to complete an epoch is written to "output/data/timings.csv". The policies of the player are written to "output/data/policies.csv"
  */
 void Experiment::conductExperiment() {
-    printf("\nEXPERIMENT IN PROGRESS\n");
+    printf("\nEXPERIMENT IN PROGRESS (seed %llu)\n", (unsigned long long)RandomServices::getMasterSeed());
     this->clearOldData();
     this->conductRuns();
     this->mazeIdentifiers = this->getMazeIdentifiers();
     this->getAveragePolicies();
     this->evaluateAveragePolicies();
-    this->writeAveragePoliciesRewards();
     this->writeData();
 }
 
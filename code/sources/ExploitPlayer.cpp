@@ -1,15 +1,17 @@
+#include <algorithm>
+#include "BatchMaze.hpp"
 #include "ExploitPlayer.hpp"
 
 /**
  * Constructs an exploit player.
  *
  * @param m The maze for the player to solve.
- * @param policy The policy used to solve the maze with.
+ * @param policy The policy used to solve the maze with, laid out as [state][action].
+ * @param lanes The number of episodes to play, in lockstep.
  */
-ExploitPlayer::ExploitPlayer(Maze *m, std::map<State*, std::vector<double>> policy) : Player(m) {
-    this->currentEpoch = 0;
-    this->timeoutEpoch = std::ceil(Player::EPISODE_TIMEOUT_FRACTION * this->maze->getStates()->size());
-    this->policy = std::move(policy);
+ExploitPlayer::ExploitPlayer(Maze *m, std::vector<double> policy, int lanes) : Player(m, std::move(policy)) {
+    this->laneNumber = std::max(lanes, 1);
+    this->timeoutEpoch = std::ceil(Player::EPISODE_TIMEOUT_FRACTION * this->maze->getCellNumber());
 }
 
 /**
@@ -22,7 +24,7 @@ ExploitPlayer::~ExploitPlayer() = default;
  *
  * @return The initial state-action pair.
  */
-State *ExploitPlayer::initialState() {
+int ExploitPlayer::initialState() {
     return this->maze->getStartingState();
 }
 
@@ -32,30 +34,82 @@ State *ExploitPlayer::initialState() {
  * @param s The current state-action pair.
  * @return The successor tuple.
  */
-State *ExploitPlayer::nextState(State *s) {
+int ExploitPlayer::nextState(int s) {
     Maze::Actions chosenAction;
-    std::tuple<State*, double> results;
+    std::tuple<int, double> results;
     chosenAction = this->chooseAction(s);
     results = this->maze->getStateTransitionResult(s, chosenAction);
     this->rewards.push_back(std::get<1>(results));
     return std::get<0>(results);
 }
 
+/**
+ * Plays one episode per lane, all in lockstep, on a batch of mazes sharing
+ * the player's layout.
+ *
+ * Each lane's episode ends as a single one would: in a terminal state, or on
+ * timeout.
+ */
+void ExploitPlayer::solveMazeInBatch() {
+    int lane, activeLanes;
+    BatchMaze batch(this->maze->getLayout(), this->laneNumber);
+    std::vector<int> states(this->laneNumber), nextStates(this->laneNumber), steps(this->laneNumber, 0);
+    std::vector<Maze::Actions> actions(this->laneNumber);
+    std::vector<double> stepRewards(this->laneNumber);
+    std::vector<char> done(this->laneNumber, 0), active(this->laneNumber, 1);
+    this->rewardTotals.assign(this->laneNumber, 0.0);
+    for (lane = 0; lane < this->laneNumber; lane++) {
+        states[lane] = batch.startEpisode(lane);
+    }
+    activeLanes = this->laneNumber;
+    while (activeLanes > 0) {
+        for (lane = 0; lane < this->laneNumber; lane++) {
+            if (!done[lane]) {
+                actions[lane] = this->chooseAction(states[lane]);
+            }
+        }
+        batch.step(states.data(), actions.data(), nextStates.data(), stepRewards.data(), done.data());
+        for (lane = 0; lane < this->laneNumber; lane++) {
+            if (!active[lane]) {
+                continue;
+            }
+            this->rewardTotals[lane] += stepRewards[lane];
+            states[lane] = nextStates[lane];
+            if (done[lane] || ++steps[lane] >= this->timeoutEpoch) {
+                active[lane] = 0;
+                done[lane] = 1;
+                activeLanes--;
+            }
+        }
+    }
+}
+
 /**
  * Solves the maze the player was assigned to address.
+ *
+ * With multiple lanes, one episode is played per lane; see getRewardTotals().
+ * The player may solve the maze any number of times: only the episode's own
+ * step count and rewards are reset beforehand, and the maze resets only what
+ * the episode changed, so that no call costs time in the number of states.
  */
 void ExploitPlayer::solveMaze() {
-    State *s;
+    int s;
+    if (this->laneNumber > 1) {
+        this->solveMazeInBatch();
+        return;
+    }
+    this->currentEpoch = 0;
+    this->rewards.clear();
     s = this->initialState();
     do {
         s = this->nextState(s);
         this->currentEpoch++;
-    } while (!Player::maximumIterationReached() && !Maze::stateIsTerminal(s));
+    } while (!Player::maximumIterationReached() && !this->maze->stateIsTerminal(s));
     this->maze->resetMaze();
 }
 
 /**
- * Obtains the total reward gathered by the player while solving the maze.
+ * Obtains the total reward gathered by the player while last solving the maze.
  *
  * @return The reward total obtained.
  */
@@ -67,4 +121,143 @@ double ExploitPlayer::getRewardTotal() {
         total += this->rewards[rewardIndex];
     }
     return total;
+}
+
+/**
+ * Obtains the total reward gathered in each episode the player last played.
+ *
+ * @return The reward totals, one per lane.
+ */
+std::vector<double> ExploitPlayer::getRewardTotals() {
+    if (this->laneNumber > 1) {
+        return this->rewardTotals;
+    }
+    return std::vector<double>(1, this->getRewardTotal());
+}
+
+/**
+ * Obtains the probabilities of a state's actions, scaled to sum to one.
+ *
+ * States without any probability mass choose uniformly, as they do when
+ * playing.
+ *
+ * @param s The index of the state.
+ * @param probabilities Output parameter. The probability of each action.
+ */
+void ExploitPlayer::normalisedStatePolicy(int s, double *probabilities) {
+    int actionIndex;
+    double total;
+    total = 0.0;
+    for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+        probabilities[actionIndex] = this->policyProbability(s, Maze::actionFromIndex(actionIndex));
+        total += probabilities[actionIndex];
+    }
+    for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+        probabilities[actionIndex] = (total > 0.0 ? probabilities[actionIndex] / total :
+                1.0 / (double)Maze::ACTION_NUMBER);
+    }
+}
+
+/**
+ * Computes the reward total the player obtains in an episode, in expectation.
+ *
+ * The distribution over states is propagated from the starting distribution
+ * through the absorbing Markov chain the policy induces, for as many steps as
+ * an episode may take before timing out. Each step adds its expected reward,
+ * and only expands the states that hold probability mass, in the order they
+ * were reached in. Propagation stops early once all but a negligible share of
+ * the episodes has ended.
+ *
+ * The mass still held at a step is the chance that an episode is still being
+ * played, so its running sum is the expected length of the episodes thus far.
+ * When mass spreads over many states, as with aimless policies, propagation
+ * may cost more than playing the episodes would. It is therefore given up as
+ * soon as it has expanded more states than the given number of episodes is
+ * expected to have taken steps.
+ *
+ * This is only exact for static mazes, whose transition table describes them
+ * completely.
+ *
+ * @param episodeNumber The number of played episodes the computation stands
+ *      in for.
+ * @param total Output parameter. The expected reward total.
+ * @return Whether the computation finished within its budget.
+ */
+bool ExploitPlayer::expectedRewardTotal(int episodeNumber, double *total) {
+    int s, next, step, stateIndex, actionIndex, rotationIndex, startIndex;
+    long long expansions;
+    double remainder, expectedSteps, probability, outcomeProbability, probabilities[Maze::ACTION_NUMBER];
+    const Maze::Transition *outcomes;
+    std::vector<double> mass, upcomingMass;
+    std::vector<int> slots, active, upcomingActive;
+    const std::vector<int> &startingStates = this->maze->getLayout()->getStartingStates();
+    const std::vector<int> &nontrivialStates = this->maze->getLayout()->getNontrivialStates(false);
+    const std::vector<int> &initialStates = (startingStates.empty() ? nontrivialStates : startingStates);
+    /* The position of each upcoming state within the upcoming states, or -1. */
+    slots.assign(this->maze->getStateNumber(), -1);
+    for (startIndex = 0; startIndex < (int)initialStates.size(); startIndex++) {
+        s = initialStates[startIndex];
+        if (slots[s] < 0) {
+            slots[s] = (int)active.size();
+            active.push_back(s);
+            mass.push_back(0.0);
+        }
+        mass[slots[s]] += 1.0 / (double)initialStates.size();
+    }
+    for (stateIndex = 0; stateIndex < (int)active.size(); stateIndex++) {
+        slots[active[stateIndex]] = -1;
+    }
+    *total = 0.0;
+    expansions = 0;
+    expectedSteps = 0.0;
+    remainder = 1.0;
+    for (step = 0; step < this->timeoutEpoch && !active.empty(); step++) {
+        expansions += (long long)active.size();
+        expectedSteps += remainder;
+        if ((double)expansions > episodeNumber * expectedSteps) {
+            return false;
+        }
+        remainder = 0.0;
+        upcomingActive.clear();
+        upcomingMass.clear();
+        for (stateIndex = 0; stateIndex < (int)active.size(); stateIndex++) {
+            s = active[stateIndex];
+            this->normalisedStatePolicy(s, probabilities);
+            for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+                probability = mass[stateIndex] * probabilities[actionIndex];
+                if (probability == 0.0) {
+                    continue;
+                }
+                outcomes = this->maze->getTransitions(s, Maze::actionFromIndex(actionIndex));
+                for (rotationIndex = 0; rotationIndex < Maze::ACTION_NUMBER; rotationIndex++) {
+                    outcomeProbability = probability * outcomes[rotationIndex].probability;
+                    if (outcomeProbability == 0.0) {
+                        continue;
+                    }
+                    next = outcomes[rotationIndex].nextIndex;
+                    *total += outcomeProbability * outcomes[rotationIndex].reward;
+                    if (this->maze->stateIsTerminal(next)) {
+                        continue;
+                    }
+                    if (slots[next] < 0) {
+                        slots[next] = (int)upcomingActive.size();
+                        upcomingActive.push_back(next);
+                        upcomingMass.push_back(0.0);
+                    }
+                    upcomingMass[slots[next]] += outcomeProbability;
+                    remainder += outcomeProbability;
+                }
+            }
+        }
+        for (stateIndex = 0; stateIndex < (int)upcomingActive.size(); stateIndex++) {
+            slots[upcomingActive[stateIndex]] = -1;
+        }
+        active.swap(upcomingActive);
+        mass.swap(upcomingMass);
+        if (remainder < REMAINDER_TOLERANCE) {
+            /* (Nearly) all episodes have ended. */
+            break;
+        }
+    }
+    return true;
 }
\ No newline at end of file
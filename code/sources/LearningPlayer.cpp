@@ -15,16 +15,26 @@ LearningPlayer::LearningPlayer(Maze *m, double gamma, int T, bool initialiseStoc
     this->initialiseStateActionValues();
 }
 
+/**
+ * Obtains the flat index of a state-action pair into state-action tables.
+ *
+ * @param stateActionPair The state-action pair.
+ * @return The pair's index.
+ */
+int LearningPlayer::stateActionIndex(std::tuple<int, Maze::Actions> stateActionPair) {
+    return std::get<0>(stateActionPair) * Maze::ACTION_NUMBER + std::get<1>(stateActionPair);
+}
+
 /**
  * This function sets a value in state-action values of a certain state-action pair to the 
  * given value.
  * 
- * @param s The state 
+ * @param s The index of the state
  * @param action The action
  * @param value The state-action value for the given state-action pair
  */
-void LearningPlayer::setStateActionValue(State *s, Maze::Actions action, double value) {
-    this->stateActionValues[std::make_tuple(s, action)] = value;
+void LearningPlayer::setStateActionValue(int s, Maze::Actions action, double value) {
+    this->stateActionValues[s * Maze::ACTION_NUMBER + action] = value;
 }
 
 /**
@@ -32,17 +42,7 @@ void LearningPlayer::setStateActionValue(State *s, Maze::Actions action, double
  * later used to update the policy of a player.
  */
 void LearningPlayer::initialiseStateActionValues() {
-    int i;
-    State *state;
-    std::vector<State>* states;
-    states = this->maze->getStates();
-    for (i = 0; i < (int)states->size(); i++) {
-        state = &(states->at(i));
-        this->setStateActionValue(state, Maze::Actions::moveUp, INITIAL_STATE_ACTION_VALUE);
-        this->setStateActionValue(state, Maze::Actions::moveRight, INITIAL_STATE_ACTION_VALUE);
-        this->setStateActionValue(state, Maze::Actions::moveDown, INITIAL_STATE_ACTION_VALUE);
-        this->setStateActionValue(state, Maze::Actions::moveLeft, INITIAL_STATE_ACTION_VALUE);
-    }
+    this->stateActionValues.assign(this->maze->getStateNumber(), INITIAL_STATE_ACTION_VALUE);
 }
 
 /**
@@ -53,29 +53,11 @@ LearningPlayer::~LearningPlayer() = default;
 /**
  * Returns the action with the highest stateActionValue in the provided state.
  *
- * @param s the state for which the action has to be chosen
+ * @param s the index of the state for which the action has to be chosen
  * @return an action
  */
-Maze::Actions LearningPlayer::greedyAction(State *s) {
-    int actionIndex;
-    std::tuple<State*, Maze::Actions> stateActionPair;
-    Maze::Actions currentAction, bestAction;
-    double current, best;
-    bestAction = Maze::actionFromIndex(0);
-    stateActionPair = std::make_tuple(s, bestAction);
-    best = this->stateActionValues[stateActionPair];
-    for (actionIndex = 1; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-        /* Per alternative action, check whether it trumps our current
-           action. */
-        currentAction = Maze::actionFromIndex(actionIndex);
-        stateActionPair = std::make_tuple(s, currentAction);
-        current = this->stateActionValues[stateActionPair];
-        if (current > best) {
-            bestAction = currentAction;
-            best = current;
-        }
-    }
-    return bestAction;
+Maze::Actions LearningPlayer::greedyAction(int s) {
+    return this->stateActionValues.greedyAction(s);
 }
 
 /**
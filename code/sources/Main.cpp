@@ -1,6 +1,9 @@
 #include "RandomServices.hpp"
 #include "Maze.hpp"
 #include "UserInput.hpp"
+#include "Configuration.hpp"
+#include "MazeGenerator.hpp"
+#include "MazeFile.hpp"
 
 /**
  * Executes the program.
@@ -10,8 +13,21 @@
  * @return The exit signal.
  */
 int main(int argc, char *argv[]) {
-    RandomServices::initialiseRandomServices();
-    Experiment e = UserInput::experimentFromUserInput();
+    MazeGenerator generator;
+    Configuration configuration = Configuration::fromArguments(argc, argv);
+    if (configuration.writesGeneratedMaze()) {
+        if (!MazeGenerator::fromSpecification(configuration.getGeneratorSpecification(), &generator)) {
+            return EXIT_FAILURE;
+        }
+        generator.generate();
+        return (generator.writeMaze(configuration.getGeneratorOutputFile()) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    if (configuration.convertsMaze()) {
+        return (MazeFile::convert(configuration.getConversionInputFile(), configuration.getConversionOutputFile()) ?
+                EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    RandomServices::initialiseRandomServices(configuration.getSeed());
+    Experiment e = UserInput::experimentFromUserInput(configuration);
     e.conductExperiment();
     return EXIT_SUCCESS;
 }
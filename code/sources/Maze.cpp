@@ -1,269 +1,228 @@
-#include <iostream>
-#include <fstream>
-#include <sstream>
 #include "RandomServices.hpp"
 #include "Maze.hpp"
 
 /**
- * Associates an input character to a state's tile type.
- *
- * @param input The input character to associate a tile type to.
- * @return The tile type.
- */
-State::Types Maze::typeFromInput(char input) {
-    switch (input) {
-        case '.':
-            return State::Types::path;
-        case '*':
-            return State::Types::start;
-        case '1':
-            return State::Types::goal;
-        case '0':
-            return State::Types::warp;
-        case ':':
-            return State::Types::lever;
-        case '|':
-            return State::Types::gate;
-        case '%':
-            return State::Types::snack;
-        case '#':
-            return State::Types::pit;
-        default:
-            return State::Types::none;
-    }
-}
+ * Constructs a maze on top of a (possibly shared) layout.
+ *
+ * The maze holds nothing but the layout and its own episode's dynamics, so
+ * any number of mazes may share one layout, on any number of threads.
+ *
+ * @param layout The layout of the maze.
+ */
+Maze::Maze(std::shared_ptr<const MazeLayout> layout) : layout(std::move(layout)) {}
 
 /**
- * Sets this maze's dimensions by reading from input.
+ * Constructs a maze with a layout of its own.
+ *
+ * For details on layout construction, see MazeLayout.
  *
- * Two arguments are expected. The first is width, the second height.
+ * @param mps The relative movement probabilities, ordered clockwise, starting
+ *      in the intended direction.
+ * @param inputFile The relative path to the file from which to read, a
+ *      generator specification, or an empty string.
  */
-void Maze::getMazeDimensionsFromInput() {
-    scanf("%d %d", &(this->width), &(this->height));
-}
+Maze::Maze(std::tuple<double, double, double, double> mps, const std::string& inputFile) :
+        layout(std::make_shared<const MazeLayout>(mps, inputFile)) {}
 
 /**
- * Sets this maze's dimensions by reading from a plain text file.
+ * Constructs a maze with a layout of its own.
  *
- * Two arguments are expected. The first is width, the second height.
+ * This is the shortened constructor for mazes, in which pre-specified relative
+ * movement probabilities are set. Only the input file is required.
  *
- * @param inputStream The input stream for the text file.
+ * @param inputFile The relative path to the file from which to read, a
+ *      generator specification, or an empty string.
  */
-void Maze::getMazeDimensionsFromFile(std::ifstream *inputStream) {
-    int w, h;
-    std::string line;
-    std::getline(*inputStream, line);
-    std::istringstream stream(line);
-    if (!(stream >> w >> h)) {
-        printf("[Maze] Error: Could not read width and height. Aborting.\n");
-    } else {
-        this->width = w;
-        this->height = h;
-    }
-}
+Maze::Maze(const std::string& inputFile) : layout(std::make_shared<const MazeLayout>(inputFile)) {}
 
 /**
- * Sets this maze's states by reading from input.
+ * Destructs a maze.
+ */
+Maze::~Maze() = default;
+
+/**
+ * Determines whether players start at a random legal tile.
+ *
+ * If no explicitly designated starting states are given, players start at
+ * arbitrary starting tiles.
  *
- * States are represented by characters. For an overview of all valid
- * characters, we recommend consulting this source file's header. Spaces entail
- * no state. Newlines start new rows of the maze.
- *   This method assumes the dimensions of the maze are already configured.
+ * @return The question's answer.
  */
-void Maze::getMazeStatesFromInput() {
-    int x, y;
-    char input;
-    getchar();
-    for (y = 0; y < this->height; y++) {
-        for (x = 0; x < (this->width + 1); x++) {
-            scanf("%c", &input);
-            if (x != this->width) {
-                this->states.emplace_back(x, y, this->typeFromInput(input));
-            }
-        }
-    }
+bool Maze::shouldStartAtRandomPosition() {
+    return this->layout->getStartingStates().empty();
 }
 
 /**
- * Sets this maze's states by reading from a plain text file.
+ * Obtains the state index associated with a state's coordinates.
  *
- * States are represented by characters. For an overview of all valid
- * characters, we recommend consulting this source file's header. Spaces entail
- * no state. Newlines start new rows of the maze.
- *   This method assumes the dimensions of the maze are already configured.
+ * @param x The state's horizontal coordinate.
+ * @param y The state's vertical coordinate.
+ * @return The state's index, or -1 if the coordinates hold a wall.
+ */
+int Maze::indexFromCoordinates(int x, int y) {
+    return this->layout->indexFromCoordinates(x, y);
+}
+
+/**
+ * Clears the maze's opened gates and eaten snacks.
  *
- * @param inputStream The input stream for the text file.
+ * This method needs to be called whenever a player has finished an episode
+ * through the maze. It takes constant time.
  */
-void Maze::getMazeStatesFromFile(std::ifstream *inputStream) {
-    int x, y;
-    char input;
-    for (y = 0; y < this->height; y++) {
-        for (x = 0; x < (this->width + 1); x++) {
-            input = inputStream->get();
-            if (x != this->width) {
-                this->states.emplace_back(x, y, this->typeFromInput(input));
-            }
-        }
-    }
+void Maze::resetMaze() {
+    this->dynamics.reset();
 }
 
 /**
- * Among all this maze's states, stores those states that are special.
- *
- * A state is deemed special if it is a starting tile, a gate, or a goal.
- */
-void Maze::getMazeSpecialStates() {
-    int i;
-    State *s = nullptr;
-    for (i = 0; i < (int)this->states.size(); i++) {
-        s = &(this->states[i]);
-        switch (s->getType()) {
-            case State::Types::start:
-                this->startingStates.push_back(s);
-                break;
-            case State::Types::gate:
-                this->gateStates.push_back(s);
-                break;
-            case State::Types::goal:
-                this->goalStates.push_back(s);
-                break;
-            default:
-                break;
-        }
-    }
+ * Obtains the maze's (immutable) layout.
+ *
+ * @return The layout.
+ */
+const MazeLayout* Maze::getLayout() {
+    return this->layout.get();
 }
 
 /**
- * Constructs a maze.
+ * Obtains the dynamics of the maze's current episode.
  *
- * This is the full-fledged constructor for mazes.
- *   Mazes are either constructed from input or from a plain text file. By
- * supplying an empty relative path string, the maze is construed from input;
- * otherwise it is built from the given plain text file.
- *   Four relative movement probabilities must be supplied, which are required
- * to sum to one (certain probabilities may be zero). These represent the
- * probabilities of moving in certain relative directions from the intended
- * direction. They are listed in a clockwise manner, starting from the direction
- * which was intended.
+ * @return A copy of the dynamics.
+ */
+MazeDynamics Maze::getDynamics() {
+    return this->dynamics;
+}
+
+/**
+ * Overwrites the dynamics of the maze's current episode.
  *
- * @param mps The relative movement probabilities, ordered clockwise, starting
- *      in the intended direction.
- * @param inputFile The relative path to the file from which to read, or an
- *      empty string.
- */
-Maze::Maze(std::tuple<double, double, double, double> mps, const std::string& inputFile) : mazeIdentifier(inputFile) {
-    if (inputFile.empty()) {
-        /* Read from input. */
-        printf("Please input your self-built maze.\n");
-        printf("  Syntax (Step 1): Enter width, height (two integers greater than zero).\n");
-        printf("  Syntax (Step 2): Enter rows of maze, represented by characters, ending in ENTER.\n");
-        printf("  Legal characters:\n");
-        printf("    (.) Path, (*) Start, (1) Goal, (0) Warp, (:) Lever, (|) Gate, (%%) Snack, (#) Pit, ( ) Empty.\n");
-        this->getMazeDimensionsFromInput();
-        this->getMazeStatesFromInput();
-    } else {
-        /* Read from a plain text file. */
-        std::ifstream inputStream(inputFile);
-        this->getMazeDimensionsFromFile(&inputStream);
-        this->getMazeStatesFromFile(&inputStream);
-    }
-    this->getMazeSpecialStates();
-    this->moveProbabilities = mps;
+ * @param dynamics The dynamics to continue with.
+ */
+void Maze::setDynamics(MazeDynamics dynamics) {
+    this->dynamics = dynamics;
 }
 
 /**
- * Constructs a maze.
+ * Obtains the number of states of this maze.
  *
- * This is the shortened constructor for mazes, in which pre-specified relative
- * movement probabilities are set. Only the input file is required.
- *   For details on maze construction, see the full-fledged constructor above.
+ * States are the maze's traversable cells only, indexed densely, from zero up
+ * to (but excluding) this number.
  *
- * @param inputFile The relative path to the file from which to read, or an
- *      empty string.
+ * @return The number of states.
  */
-Maze::Maze(const std::string& inputFile) : Maze(std::make_tuple(0.8, 0.1, 0.0, 0.1), std::move(inputFile)) {}
+int Maze::getStateNumber() {
+    return this->layout->getStateNumber();
+}
 
 /**
- * Destructs a maze.
+ * Obtains the number of cells of this maze, walls included.
+ *
+ * @return The number of cells, being the maze's width times its height.
  */
-Maze::~Maze() = default;
+int Maze::getCellNumber() {
+    return this->layout->getCellNumber();
+}
 
 /**
- * Determines whether players start at a random legal tile.
- *
- * If no explicitly designated starting states are given, players start at
- * arbitrary starting tiles.
+ * Determines whether the maze never changes, nor moves players around.
  *
  * @return The question's answer.
  */
-bool Maze::shouldStartAtRandomPosition() {
-    return this->startingStates.empty();
+bool Maze::isStatic() {
+    return this->layout->isStatic();
 }
 
 /**
- * Obtains the state index associated with a state's coordinates.
+ * Obtains the cell a state occupies.
  *
- * @param x The state's horizontal coordinate.
- * @param y The state's vertical coordinate.
- * @return The state's index.
+ * @param stateIndex The state's index.
+ * @return The cell's index, counted row by row over the maze's full width.
  */
-int Maze::indexFromCoordinates(int x, int y) {
-    return y * this->width + x;
+int Maze::getCellOfState(int stateIndex) {
+    return this->layout->getCellOfState(stateIndex);
 }
 
 /**
- * Clears the maze's states' activations.
+ * Obtains the state occupying a cell.
  *
- * This method needs to be called whenever a player has finished an episode
- * through the maze.
+ * @param cellIndex The cell's index, counted row by row over the maze's full
+ *      width.
+ * @return The state's index, or -1 if the cell is a wall.
  */
-void Maze::resetMaze() {
-    int stateIndex;
-    for (stateIndex = 0; stateIndex < (int)this->states.size(); stateIndex++) {
-        this->states[stateIndex].setActivation(false);
-    }
+int Maze::getStateOfCell(int cellIndex) {
+    return this->layout->getStateOfCell(cellIndex);
 }
 
 /**
- * Obtains a reference to the collection of states of this maze.
+ * Obtains the horizontal coordinate of the state at the given index.
  *
- * @return The reference to the states.
+ * @param stateIndex The state's index.
+ * @return The state's horizontal coordinate.
  */
-std::vector<State>* Maze::getStates() {
-    return &(this->states);
+int Maze::getStateX(int stateIndex) {
+    return this->layout->getStateX(stateIndex);
 }
 
 /**
- * Obtains a reference to a state, given its index.
+ * Obtains the vertical coordinate of the state at the given index.
  *
- * @param index The state's index.
- * @return A reference to the state at the given index.
+ * @param stateIndex The state's index.
+ * @return The state's vertical coordinate.
  */
-State* Maze::getState(int index) {
-    return &(this->states[index]);
+int Maze::getStateY(int stateIndex) {
+    return this->layout->getStateY(stateIndex);
+}
+
+/**
+ * Obtains the tile type of the state at the given index.
+ *
+ * Once the gates are open, gates and levers become paths; so do snacks once
+ * they have been eaten.
+ *
+ * @param stateIndex The state's index.
+ * @return The state's tile type.
+ */
+State::Types Maze::getStateType(int stateIndex) {
+    State::Types t;
+    t = this->layout->getStateType(stateIndex);
+    switch (t) {
+        case State::Types::gate:
+        case State::Types::lever:
+            return (this->dynamics.gatesAreOpen() ? State::Types::path : t);
+        case State::Types::snack:
+            return (this->dynamics.snackIsEaten(this->layout->getSnackNumber(stateIndex)) ? State::Types::path : t);
+        default:
+            return t;
+    }
 }
 
 /**
  * Obtains the starting state for a player to start an episode with.
  *
- * @return The starting state.
+ * @return The index of the starting state.
  */
-State* Maze::getStartingState() {
-    int randomIndex;
-    State *s;
+int Maze::getStartingState() {
+    const std::vector<int> &startingStates = this->layout->getStartingStates();
     if (this->shouldStartAtRandomPosition()) {
-        do {
-            randomIndex = RandomServices::discreteUniformSample((int)this->states.size() - 1);
-            s = &(this->states[randomIndex]);
-        } while (Maze::stateIsTerminal(s) || Maze::stateIsIntraversible(s));
-    } else {
-        /* From the designated starting states, choose one randomly. */
-        do {
-            randomIndex = RandomServices::discreteUniformSample((int)this->startingStates.size() - 1);
-            s = this->startingStates[randomIndex];
-        } while (Maze::stateIsTerminal(s) || Maze::stateIsIntraversible(s));
+        return this->getRandomNontrivialState();
     }
-    return s;
+    /* From the designated starting states (all nontrivial), choose one randomly. */
+    return startingStates[RandomServices::discreteUniformSample((int)startingStates.size() - 1)];
+}
+
+/**
+ * Obtains an arbitrary nontrivial state, given the maze's current dynamics.
+ *
+ * A state is regarded as being 'nontrivial' if it is neither terminal nor
+ * intraversible.
+ *
+ * @return The index of a random nontrivial state.
+ */
+int Maze::getRandomNontrivialState() {
+    const std::vector<int> &nontrivialStates = this->layout->getNontrivialStates(this->dynamics.gatesAreOpen());
+    if (nontrivialStates.empty()) {
+        printf("[Maze] Error: The maze has no nontrivial states. Aborting.\n");
+        exit(EXIT_FAILURE);
+    }
+    return nontrivialStates[RandomServices::discreteUniformSample((int)nontrivialStates.size() - 1)];
 }
 
 /**
@@ -277,133 +236,82 @@ Maze::Actions Maze::actionFromIndex(int index) {
 }
 
 /**
- * Given the intended action, returns the action which will actually occur.
+ * Determines the rotation from the intended direction which will actually occur.
  *
  * With the maze's relative movement probabilities, it is determined which
- * actual action gets executed.
+ * rotation of the intended action gets executed. The draw takes constant time
+ * through the layout's alias table.
  *
- * @param chosenAction The intended action.
- * @return The action that will be executed in actuality.
+ * @return The rotation that will be executed in actuality.
  */
-Maze::Actions Maze::actualAction(Maze::Actions chosenAction) {
-    int a;
-    double bar, current;
-    bar = RandomServices::continuousUniformSample(1.0);
-    current = this->getActionProbability(0);
-    for (a = 0; a < ACTION_NUMBER; a++) {
-        /* Loop through the relative movement probabilities, and choose the
-           action that 'hits the bar', i.e. the one that will be chosen. */
-        if (bar <= current) {
-            return this->actionFromIndex((chosenAction + a) % ACTION_NUMBER);
-        }
-        current += this->getActionProbability(a + 1);
-    }
-    return this->actionFromIndex(ACTION_NUMBER - 1);
+int Maze::actualRotation() {
+    return this->layout->sampleRotation();
 }
 
 /**
- * Given the coordinates of a movement's resulting state, determines validity.
+ * Given the intended action, returns the action which will actually occur.
  *
- * Notice that a state is deemed 'valid' when it resides within the maze's
- * borders. It may still be invalid due to it being an intraversible tile.
+ * With the maze's relative movement probabilities, it is determined which
+ * actual action gets executed.
  *
- * @param x The horizontal coordinate of the resulting state.
- * @param y The vertical coordinate of the resulting state.
- * @return The question's answer.
+ * @param chosenAction The intended action.
+ * @return The action that will be executed in actuality.
  */
-bool Maze::moveIsOutOfBounds(int x, int y) {
-    return (x < 0 || x >= this->width) || (y < 0 || y >= this->height);
+Maze::Actions Maze::actualAction(Maze::Actions chosenAction) {
+    return this->actionFromIndex((chosenAction + this->actualRotation()) % ACTION_NUMBER);
 }
 
 /**
- * Determines whether the given state is intraversible.
+ * Determines whether the state at the given index is intraversible.
  *
  * A state is intraversible when it does not have a tile type, or when it has
  * a locked gate as tile type.
  *
- * @param s The state to evaluate intraversiblity for.
+ * @param stateIndex The index of the state to evaluate intraversibility for.
  * @return The question's answer.
  */
-bool Maze::stateIsIntraversible(State *s) {
-    State::Types t;
-    t = s->getType();
-    return (t == State::Types::none) || (t == State::Types::gate);
+bool Maze::stateIsIntraversible(int stateIndex) {
+    return this->layout->stateIsIntraversible(stateIndex, this->dynamics.gatesAreOpen());
 }
 
 /**
- * Determines whether the given state is a termination state.
+ * Determines whether the state at the given index is a termination state.
  *
  * A state is a terminal state when it is a goal (positive case) or a pit
  * (negative case).
  *
- * @param s The state to evaluate.
+ * @param stateIndex The index of the state to evaluate.
  * @return The question's answer.
  */
-bool Maze::stateIsTerminal(State *s) {
-    State::Types t;
-    t = s->getType();
-    return (t == State::Types::goal) || (t == State::Types::pit);
+bool Maze::stateIsTerminal(int stateIndex) {
+    return this->layout->stateIsTerminal(stateIndex);
 }
 
 /**
- * Given the resulting state's coordinates, determines movement invalidity.
+ * Obtains the precomputed outcomes of performing an action in a state.
  *
- * A move is deemed invalid if it is out of bounds or if it is intraversible.
+ * The returned view holds one transition per relative rotation of the action,
+ * ordered clockwise and starting in the intended direction. It stays valid
+ * for the layout's lifetime, and reflects whether the maze's gates are open.
+ * Its rewards assume that no snack has been eaten.
  *
- * @param x The resulting state's horizontal position.
- * @param y The resulting state's vertical position.
- * @return The question's answer.
+ * @param stateIndex The index of the state from which the action is performed.
+ * @param action The action to execute.
+ * @return The action's possible outcomes.
  */
-bool Maze::moveShouldFail(int x, int y) {
-    if (this->moveIsOutOfBounds(x, y)) {
-        return true;
-    } else {
-        State *s = &(this->states[this->indexFromCoordinates(x, y)]);
-        return this->stateIsIntraversible(s);
-    }
+const Maze::Transition* Maze::getTransitions(int stateIndex, Maze::Actions action) {
+    return this->layout->getTransitions(stateIndex, action, this->dynamics.gatesAreOpen());
 }
 
 /**
- * Returns a resulting state from a state-action pair deterministically.
- *
- * 'Deterministic computation' in this method means that no maze randomness
- * is taken into account. Put differently, the chosen action is not manipulated
- * by the maze's relative movement probability effects.
+ * Obtains the states from which the given state can be reached in one step.
  *
- * @param state The state from which the action is performed.
- * @param action The action to execute.
- * @return The resulting state.
- */
-State* Maze::getNextStateDeterministic(State *state, enum Maze::Actions action) {
-    int x, y, deltas[ACTION_NUMBER][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
-    x = state->getX();
-    y = state->getY();
-    switch (action) {
-        case moveUp:
-            x += deltas[0][0];
-            y += deltas[0][1];
-            break;
-        case moveRight:
-            x += deltas[1][0];
-            y += deltas[1][1];
-            break;
-        case moveDown:
-            x += deltas[2][0];
-            y += deltas[2][1];
-            break;
-        case moveLeft:
-            x += deltas[3][0];
-            y += deltas[3][1];
-            break;
-        default:
-            break;
-    }
-    if (this->moveShouldFail(x, y)) {
-        /* Maneuver failed. Remain in the current state.  */
-        return state;
-    } else {
-        return &(this->states[this->indexFromCoordinates(x, y)]);
-    }
+ * @param stateIndex The index of the state to obtain the predecessors of.
+ * @param count Output parameter. The number of predecessors.
+ * @return The indices of the predecessors, each listed once.
+ */
+const int* Maze::getPredecessors(int stateIndex, int *count) {
+    return this->layout->getPredecessors(stateIndex, this->dynamics.gatesAreOpen(), count);
 }
 
 /**
@@ -412,12 +320,12 @@ State* Maze::getNextStateDeterministic(State *state, enum Maze::Actions action)
  * Contrary to the deterministic state-action-result computation, this method
  * does take into account maze movement randomness.
  *
- * @param s The state from which to depart.
+ * @param stateIndex The index of the state from which to depart.
  * @param action The action to undertake.
- * @return The resulting state.
+ * @return The index of the resulting state.
  */
-State* Maze::getNextState(State *s, Actions action) {
-    return this->getNextStateDeterministic(s, this->actualAction(action));
+int Maze::getNextState(int stateIndex, Actions action) {
+    return this->getTransitions(stateIndex, action)[this->actualRotation()].nextIndex;
 }
 
 /**
@@ -427,16 +335,7 @@ State* Maze::getNextState(State *s, Actions action) {
  * @return The probability of performing the given action.
  */
 double Maze::getActionProbability(int relativeIndex) {
-    switch (relativeIndex) {
-        case Rotations::Zero:
-            return std::get<0>(this->moveProbabilities);
-        case Rotations::Quarter:
-            return std::get<1>(this->moveProbabilities);
-        case Rotations::Half:
-            return std::get<2>(this->moveProbabilities);
-        default:
-            return std::get<3>(this->moveProbabilities);
-    }
+    return this->layout->getActionProbability(relativeIndex);
 }
 
 /**
@@ -444,83 +343,57 @@ double Maze::getActionProbability(int relativeIndex) {
  *
  * A warp moves the player near one of the maze's goals.
  *
- * @param s The state from which to warp.
- * @return The resulting state.
+ * @param stateIndex The index of the state from which to warp.
+ * @return The index of the resulting state.
  */
-State* Maze::getWarpStateResult(State *s) {
-    int i, x, y, deltas[ACTION_NUMBER][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
-    State *randomGoal;
-    randomGoal = this->goalStates[RandomServices::discreteUniformSample((int)this->goalStates.size() - 1)];
+int Maze::getWarpStateResult(int stateIndex) {
+    int i, goalIndex, nextIndex;
+    const std::vector<int> &goalStates = this->layout->getGoalStates();
+    goalIndex = goalStates[RandomServices::discreteUniformSample((int)goalStates.size() - 1)];
     for (i = 0; i < ACTION_NUMBER; i++) {
-        x = randomGoal->getX() + deltas[i][0];
-        y = randomGoal->getY() + deltas[i][1];
-        if (!this->moveShouldFail(x, y)) {
-            return &(this->states[this->indexFromCoordinates(x, y)]);
+        nextIndex = this->getTransitions(goalIndex, this->actionFromIndex(i))[Rotations::Zero].nextIndex;
+        if (nextIndex != goalIndex) {
+            return nextIndex;
         }
     }
     /* Theoretically impossible: Warp fails, so act as if it's a normal tile. */
-    return s;
-}
-
-/**
- * Unlocks all gates present within the maze.
- *
- * Once the maze's gates are unlocked, they are permanently (within the episode)
- * removed. As such, levers practically become paths.
- */
-void Maze::openGates() {
-    int gateStateIndex;
-    State *s;
-    for (gateStateIndex = 0; gateStateIndex < (int)this->gateStates.size(); gateStateIndex++) {
-        s = this->gateStates[gateStateIndex];
-        s->setActivation(true);
-    }
-}
-
-/**
- * Removes the snack in the specified state.
- *
- * @param s The state from which to remove the snack.
- */
-void Maze::removeSnack(State *s) {
-    s->setActivation(true);
+    return stateIndex;
 }
 
 /**
  * Given a state, computes the resulting state if it is a special state.
  *
  * Passing 'ordinary' states is defined behaviour: no side effects occur. Thus,
- * it is always safe to pass states through this method.
+ * it is always safe to pass states through this method. Levers open all gates
+ * and snacks get eaten; both only alter the maze's dynamics, never its layout.
  *
- * @param s The state to evaluate.
- * @return The resulting state.
+ * @param stateIndex The index of the state to evaluate.
+ * @return The index of the resulting state.
  */
-State* Maze::getSpecialStateResult(State *s) {
-    State *newState;
-    switch (s->getType()) {
+int Maze::getSpecialStateResult(int stateIndex) {
+    switch (this->getStateType(stateIndex)) {
         case State::Types::warp:
-            newState = this->getWarpStateResult(s);
-            return newState;
+            return this->getWarpStateResult(stateIndex);
         case State::Types::lever:
-            this->openGates();
+            this->dynamics.openGates();
             break;
         case State::Types::snack:
-            this->removeSnack(s);
+            this->dynamics.eatSnack(this->layout->getSnackNumber(stateIndex));
             break;
         default:
-            return s;
+            return stateIndex;
     }
-    return s;
+    return stateIndex;
 }
 
 /**
- * Obtains the reward associated with the state.
+ * Obtains the reward associated with the state at the given index.
  *
- * @param state The current location.
+ * @param stateIndex The index of the current location.
  * @return The associated reward.
  */
-double Maze::getReward(State *state) {
-    switch (state->getType()) {
+double Maze::getReward(int stateIndex) {
+    switch (this->getStateType(stateIndex)) {
         case State::Types::goal:
             return GOAL_REWARD;
         case State::Types::snack:
@@ -535,14 +408,17 @@ double Maze::getReward(State *state) {
 /**
  * Given a state-action pair, computes the state-prime-reward pair.
  *
- * @param s The state from which to depart.
+ * The reward is that of arriving in the resulting state, given the maze's
+ * dynamics before arrival.
+ *
+ * @param stateIndex The index of the state from which to depart.
  * @param a The action to undertake.
- * @return The resulting state-prime-reward pair.
+ * @return The resulting state-prime-reward pair, as state index and reward.
  */
-std::tuple<State*, double> Maze::getStateTransitionResult(State *s, Actions a) {
-    State *newState = this->getNextState(s, a);
-    double reward = this->getReward(newState);
-    newState = this->getSpecialStateResult(newState);
+std::tuple<int, double> Maze::getStateTransitionResult(int stateIndex, Actions a) {
+    const Transition *outcome = this->getTransitions(stateIndex, a) + this->actualRotation();
+    double reward = this->getReward(outcome->nextIndex);
+    int newState = this->getSpecialStateResult(outcome->nextIndex);
     return std::make_tuple(newState, reward);
 }
 
@@ -575,7 +451,7 @@ std::string Maze::actionAsString(enum Maze::Actions a) {
  * @return The maze's identifier.
  */
 std::string Maze::getMazeIdentifier() {
-    return this->mazeIdentifier;
+    return this->layout->getMazeIdentifier();
 }
 
 /**
@@ -584,7 +460,7 @@ std::string Maze::getMazeIdentifier() {
  * @return The maze's width.
  */
 int Maze::getMazeWidth() {
-    return this->width;
+    return this->layout->getMazeWidth();
 }
 
 /**
@@ -593,5 +469,5 @@ int Maze::getMazeWidth() {
  * @return The maze's height.
  */
 int Maze::getMazeHeight() {
-    return this->height;
+    return this->layout->getMazeHeight();
 }
@@ -0,0 +1,69 @@
+#include "MazeDynamics.hpp"
+
+/**
+ * Constructs the dynamics of a fresh episode: gates closed, snacks uneaten.
+ */
+MazeDynamics::MazeDynamics() {
+    this->switches = 0;
+}
+
+/**
+ * Constructs dynamics from a previously obtained switch bitmask.
+ *
+ * @param switches The bitmask, as obtained from getSwitches.
+ */
+MazeDynamics::MazeDynamics(uint64_t switches) {
+    this->switches = switches;
+}
+
+/**
+ * Returns the dynamics to those of a fresh episode.
+ */
+void MazeDynamics::reset() {
+    this->switches = 0;
+}
+
+/**
+ * Determines whether a lever has opened the maze's gates.
+ *
+ * @return The question's answer.
+ */
+bool MazeDynamics::gatesAreOpen() const {
+    return (this->switches & GATE_SWITCH) != 0;
+}
+
+/**
+ * Opens the maze's gates. Once opened, they stay so until a reset.
+ */
+void MazeDynamics::openGates() {
+    this->switches |= GATE_SWITCH;
+}
+
+/**
+ * Determines whether the given snack has been eaten.
+ *
+ * @param snackNumber The number of the snack within its layout.
+ * @return The question's answer.
+ */
+bool MazeDynamics::snackIsEaten(int snackNumber) const {
+    return (this->switches & (GATE_SWITCH << (snackNumber + 1))) != 0;
+}
+
+/**
+ * Marks the given snack as eaten.
+ *
+ * @param snackNumber The number of the snack within its layout.
+ */
+void MazeDynamics::eatSnack(int snackNumber) {
+    this->switches |= (GATE_SWITCH << (snackNumber + 1));
+}
+
+/**
+ * Obtains the bitmask of switches. The lowest bit tells whether the gates are
+ * open; the bit above it, whether the first snack was eaten, and so on.
+ *
+ * @return The bitmask.
+ */
+uint64_t MazeDynamics::getSwitches() const {
+    return this->switches;
+}
\ No newline at end of file
@@ -0,0 +1,312 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "State.hpp"
+#include "MazeLayout.hpp"
+#include "MazeFile.hpp"
+
+const char MazeFile::MAGIC[8] = {'R', 'L', 'M', 'A', 'Z', 'E', '\0', '\0'};
+
+/**
+ * Obtains the number of bytes the tile types take up, padding included.
+ *
+ * @param tileNumber The number of tiles.
+ * @return The number of bytes.
+ */
+size_t MazeFile::typesLength(int tileNumber) {
+    return ((size_t)tileNumber + 3) / 4 * 4;
+}
+
+/**
+ * Checks that the mapped file is a complete binary maze of this version.
+ *
+ * The special states must be listed in increasing order, and be of the type
+ * their list is for.
+ *
+ * @param path The path of the file, for error messages.
+ * @return Whether the file is valid.
+ */
+bool MazeFile::validate(const std::string& path) {
+    int listIndex, entryIndex, tileNumber, state;
+    const State::Types listTypes[SPECIAL_STATE_LISTS] = {State::Types::start, State::Types::gate, State::Types::goal,
+            State::Types::snack};
+    size_t expectedLength;
+    const unsigned char *bytes;
+    bytes = (const unsigned char*)this->mapping;
+    if (this->length < sizeof(Header) || memcmp(bytes, MazeFile::MAGIC, sizeof(MazeFile::MAGIC)) != 0) {
+        printf("[MazeFile] Error: '%s' is no binary maze. Ignoring.\n", path.c_str());
+        return false;
+    }
+    this->header = (const Header*)bytes;
+    if (this->header->version != VERSION) {
+        printf("[MazeFile] Error: '%s' has version %u, rather than %u. Ignoring.\n", path.c_str(),
+                this->header->version, (unsigned int)VERSION);
+        return false;
+    }
+    if (this->header->width <= 0 || this->header->height <= 0 ||
+            (int64_t)this->header->width * this->header->height > INT32_MAX) {
+        printf("[MazeFile] Error: '%s' has invalid dimensions. Ignoring.\n", path.c_str());
+        return false;
+    }
+    tileNumber = this->header->width * this->header->height;
+    expectedLength = sizeof(Header) + MazeFile::typesLength(tileNumber);
+    for (listIndex = 0; listIndex < SPECIAL_STATE_LISTS; listIndex++) {
+        expectedLength += sizeof(int32_t) * (size_t)this->header->specialStateNumbers[listIndex];
+    }
+    if (this->length != expectedLength) {
+        printf("[MazeFile] Error: '%s' is %zu bytes long, rather than %zu. Ignoring.\n", path.c_str(),
+                this->length, expectedLength);
+        return false;
+    }
+    this->types = bytes + sizeof(Header);
+    for (entryIndex = 0; entryIndex < tileNumber; entryIndex++) {
+        if (this->types[entryIndex] > State::Types::none) {
+            printf("[MazeFile] Error: '%s' has an invalid tile at %d. Ignoring.\n", path.c_str(), entryIndex);
+            return false;
+        }
+    }
+    this->specialStates[0] = (const int32_t*)(this->types + MazeFile::typesLength(tileNumber));
+    for (listIndex = 1; listIndex < SPECIAL_STATE_LISTS; listIndex++) {
+        this->specialStates[listIndex] = this->specialStates[listIndex - 1] +
+                this->header->specialStateNumbers[listIndex - 1];
+    }
+    for (listIndex = 0; listIndex < SPECIAL_STATE_LISTS; listIndex++) {
+        for (entryIndex = 0; entryIndex < (int)this->header->specialStateNumbers[listIndex]; entryIndex++) {
+            state = this->specialStates[listIndex][entryIndex];
+            if (state < 0 || state >= tileNumber || this->types[state] != listTypes[listIndex] ||
+                    (entryIndex > 0 && state <= this->specialStates[listIndex][entryIndex - 1])) {
+                printf("[MazeFile] Error: '%s' has an invalid special state. Ignoring.\n", path.c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Unmaps the file, if any is mapped.
+ */
+void MazeFile::close() {
+    if (this->mapping != nullptr) {
+        munmap(this->mapping, this->length);
+    }
+    this->mapping = nullptr;
+    this->length = 0;
+    this->header = nullptr;
+    this->types = nullptr;
+}
+
+/**
+ * Constructs a binary maze file, not yet associated to any actual file.
+ */
+MazeFile::MazeFile() {
+    this->mapping = nullptr;
+    this->length = 0;
+    this->header = nullptr;
+    this->types = nullptr;
+    memset(this->specialStates, 0, sizeof(this->specialStates));
+}
+
+/**
+ * Destructs the binary maze file, unmapping it.
+ */
+MazeFile::~MazeFile() {
+    this->close();
+}
+
+/**
+ * Determines whether a path refers to a binary maze file, by its extension.
+ *
+ * @param path The path.
+ * @return The question's answer.
+ */
+bool MazeFile::isBinary(const std::string& path) {
+    std::string extension = EXTENSION;
+    return path.size() > extension.size() &&
+            path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/**
+ * Maps a binary maze file into memory.
+ *
+ * The file's contents are used in place, never copied. The mapping is private
+ * and read-only, so that any number of layouts may share its pages.
+ *
+ * @param path The path of the file.
+ * @return Whether the file was mapped and found valid.
+ */
+bool MazeFile::open(const std::string& path) {
+    int descriptor;
+    struct stat status;
+    this->close();
+    descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0 || fstat(descriptor, &status) != 0 || status.st_size == 0) {
+        printf("[MazeFile] Error: Could not open '%s'. Ignoring.\n", path.c_str());
+        if (descriptor >= 0) {
+            ::close(descriptor);
+        }
+        return false;
+    }
+    this->length = (size_t)status.st_size;
+    this->mapping = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (this->mapping == MAP_FAILED) {
+        printf("[MazeFile] Error: Could not map '%s'. Ignoring.\n", path.c_str());
+        this->mapping = nullptr;
+        this->close();
+        return false;
+    }
+    if (!this->validate(path)) {
+        this->close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Obtains the width of the maze.
+ *
+ * @return The maze's width.
+ */
+int MazeFile::getMazeWidth() const {
+    return this->header->width;
+}
+
+/**
+ * Obtains the height of the maze.
+ *
+ * @return The maze's height.
+ */
+int MazeFile::getMazeHeight() const {
+    return this->header->height;
+}
+
+/**
+ * Obtains the relative movement probabilities the maze was saved with.
+ *
+ * @return The probabilities, ordered clockwise, starting in the intended
+ *      direction.
+ */
+std::tuple<double, double, double, double> MazeFile::getMoveProbabilities() const {
+    return std::make_tuple(this->header->moveProbabilities[0], this->header->moveProbabilities[1],
+            this->header->moveProbabilities[2], this->header->moveProbabilities[3]);
+}
+
+/**
+ * Obtains the tile types, one byte per tile, in state index order.
+ *
+ * @return The tile types, within the mapping.
+ */
+const unsigned char* MazeFile::getTypes() const {
+    return this->types;
+}
+
+/**
+ * Obtains one of the precomputed lists of special states.
+ *
+ * @param list The list to obtain.
+ * @param count Output parameter. The number of states in the list.
+ * @return The states' indices, in increasing order, within the mapping.
+ */
+const int32_t* MazeFile::getSpecialStates(SpecialStates list, int *count) const {
+    *count = (int)this->header->specialStateNumbers[list];
+    return this->specialStates[list];
+}
+
+/**
+ * Writes a maze to a binary maze file.
+ *
+ * @param path The path of the file to write.
+ * @param width The maze's width.
+ * @param height The maze's height.
+ * @param types The tile types, one byte per tile, row by row.
+ * @param moveProbabilities The relative movement probabilities, ordered
+ *      clockwise, starting in the intended direction.
+ * @return Whether the file was written.
+ */
+bool MazeFile::write(const std::string& path, int width, int height, const unsigned char *types,
+        std::tuple<double, double, double, double> moveProbabilities) {
+    int stateIndex, listIndex;
+    Header header;
+    std::vector<int32_t> lists[SPECIAL_STATE_LISTS];
+    const char padding[4] = {0, 0, 0, 0};
+    std::ofstream outputStream(path, std::ios::binary);
+    if (!outputStream) {
+        printf("[MazeFile] Error: Could not open '%s' for writing. Ignoring.\n", path.c_str());
+        return false;
+    }
+    for (stateIndex = 0; stateIndex < width * height; stateIndex++) {
+        switch (types[stateIndex]) {
+            case State::Types::start:
+                lists[Starting].push_back(stateIndex);
+                break;
+            case State::Types::gate:
+                lists[Gates].push_back(stateIndex);
+                break;
+            case State::Types::goal:
+                lists[Goals].push_back(stateIndex);
+                break;
+            case State::Types::snack:
+                lists[Snacks].push_back(stateIndex);
+                break;
+            default:
+                break;
+        }
+    }
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MazeFile::MAGIC, sizeof(MazeFile::MAGIC));
+    header.version = VERSION;
+    header.width = width;
+    header.height = height;
+    for (listIndex = 0; listIndex < SPECIAL_STATE_LISTS; listIndex++) {
+        header.specialStateNumbers[listIndex] = (uint32_t)lists[listIndex].size();
+    }
+    header.moveProbabilities[0] = std::get<0>(moveProbabilities);
+    header.moveProbabilities[1] = std::get<1>(moveProbabilities);
+    header.moveProbabilities[2] = std::get<2>(moveProbabilities);
+    header.moveProbabilities[3] = std::get<3>(moveProbabilities);
+    outputStream.write((const char*)&header, sizeof(header));
+    outputStream.write((const char*)types, (std::streamsize)width * height);
+    outputStream.write(padding, (std::streamsize)(MazeFile::typesLength(width * height) - (size_t)width * height));
+    for (listIndex = 0; listIndex < SPECIAL_STATE_LISTS; listIndex++) {
+        outputStream.write((const char*)lists[listIndex].data(),
+                (std::streamsize)(sizeof(int32_t) * lists[listIndex].size()));
+    }
+    return (bool)outputStream;
+}
+
+/**
+ * Converts a maze in the plain text format to a binary maze file.
+ *
+ * The maze is given the default movement probabilities. Rows shorter than the
+ * maze's width are padded with empty tiles.
+ *
+ * @param inputFile The path of the plain text file.
+ * @param outputFile The path of the binary file to write.
+ * @return Whether the maze was converted.
+ */
+bool MazeFile::convert(const std::string& inputFile, const std::string& outputFile) {
+    int width, height, x, y;
+    std::string line;
+    std::vector<unsigned char> types;
+    std::ifstream inputStream(inputFile);
+    std::getline(inputStream, line);
+    std::istringstream stream(line);
+    if (!inputStream || !(stream >> width >> height) || width <= 0 || height <= 0) {
+        printf("[MazeFile] Error: Could not read width and height from '%s'. Ignoring.\n", inputFile.c_str());
+        return false;
+    }
+    types.assign((size_t)width * height, (unsigned char)State::Types::none);
+    for (y = 0; y < height && std::getline(inputStream, line); y++) {
+        for (x = 0; x < width && x < (int)line.size(); x++) {
+            types[(size_t)y * width + x] = (unsigned char)MazeLayout::typeFromInput(line[x]);
+        }
+    }
+    return MazeFile::write(outputFile, width, height, types.data(), MazeLayout::defaultMoveProbabilities());
+}
\ No newline at end of file
@@ -0,0 +1,708 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include "MazeLayout.hpp"
+#include "MazeGenerator.hpp"
+
+/**
+ * Associates an algorithm's name, as used in specifications, to the algorithm.
+ *
+ * @param name The name of the algorithm.
+ * @param algorithm Output parameter. The algorithm.
+ * @return Whether the name is known.
+ */
+bool MazeGenerator::algorithmFromName(const std::string &name, Algorithms *algorithm) {
+    if (name == "backtracker") {
+        *algorithm = Algorithms::RecursiveBacktracker;
+    } else if (name == "prim") {
+        *algorithm = Algorithms::Prim;
+    } else if (name == "rooms") {
+        *algorithm = Algorithms::RoomsAndCorridors;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Sets one of the densities of special tiles, from a specification's field.
+ *
+ * Fields are of the form 'tiles=density', where the density is the fraction of
+ * the maze's open tiles to turn into the given tiles.
+ *
+ * @param field The field to parse.
+ * @return Whether the field was valid.
+ */
+bool MazeGenerator::densityFromField(const std::string &field) {
+    double density;
+    char *end;
+    std::string name;
+    std::string::size_type separator;
+    separator = field.find('=');
+    if (separator == std::string::npos) {
+        return false;
+    }
+    name = field.substr(0, separator);
+    density = strtod(field.c_str() + separator + 1, &end);
+    if (*end != '\0' || separator + 1 == field.size() || !(density >= 0.0 && density <= 1.0)) {
+        return false;
+    }
+    if (name == "pits") {
+        this->pitDensity = density;
+    } else if (name == "warps") {
+        this->warpDensity = density;
+    } else if (name == "levers") {
+        this->leverDensity = density;
+    } else if (name == "gates") {
+        this->gateDensity = density;
+    } else if (name == "snacks") {
+        this->snackDensity = density;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Draws a random integer from zero up to (but excluding) the given ceiling.
+ *
+ * The generator has an engine of its own, so that a maze only depends on its
+ * seed, and generating one leaves the players' random streams untouched.
+ *
+ * @param ceiling The exclusive upper bound. Should be positive.
+ * @return The random integer.
+ */
+int MazeGenerator::randomBelow(int ceiling) {
+    return (int)((double)(this->engine() >> 11) / 9007199254740992.0 * ceiling);
+}
+
+/**
+ * Obtains the number of columns of cells.
+ *
+ * Cells lie on the tiles with even coordinates; the tiles between them are
+ * either walls or passages.
+ *
+ * @return The number of cell columns.
+ */
+int MazeGenerator::cellColumns() const {
+    return (this->width + 1) / 2;
+}
+
+/**
+ * Obtains the number of rows of cells.
+ *
+ * @return The number of cell rows.
+ */
+int MazeGenerator::cellRows() const {
+    return (this->height + 1) / 2;
+}
+
+/**
+ * Obtains the index of the tile a cell lies on.
+ *
+ * @param cell The index of the cell.
+ * @return The index of the tile.
+ */
+int MazeGenerator::tileOfCell(int cell) const {
+    return 2 * (cell / this->cellColumns()) * this->width + 2 * (cell % this->cellColumns());
+}
+
+/**
+ * Obtains the cell next to the given one, in the given direction.
+ *
+ * @param cell The index of the cell.
+ * @param direction The direction, clockwise from up, as Maze::Actions.
+ * @return The index of the neighbouring cell, or -1 if it lies outside.
+ */
+int MazeGenerator::neighbouringCell(int cell, int direction) const {
+    int x, y;
+    x = cell % this->cellColumns();
+    y = cell / this->cellColumns();
+    switch (direction) {
+        case 0:
+            return (y > 0 ? cell - this->cellColumns() : -1);
+        case 1:
+            return (x + 1 < this->cellColumns() ? cell + 1 : -1);
+        case 2:
+            return (y + 1 < this->cellRows() ? cell + this->cellColumns() : -1);
+        default:
+            return (x > 0 ? cell - 1 : -1);
+    }
+}
+
+/**
+ * Carves a passage between two neighbouring cells.
+ *
+ * @param cell The index of the first cell.
+ * @param neighbour The index of the second cell.
+ */
+void MazeGenerator::connectCells(int cell, int neighbour) {
+    int first, second;
+    first = this->tileOfCell(cell);
+    second = this->tileOfCell(neighbour);
+    this->tiles[first] = this->tiles[second] = this->tiles[(first + second) / 2] = '.';
+}
+
+/**
+ * Carves a perfect maze by a randomised depth-first search.
+ *
+ * The search keeps an explicit stack, so that the largest mazes do not
+ * overflow the call stack. Its mazes have long, winding corridors.
+ */
+void MazeGenerator::carveRecursiveBacktracker() {
+    int cell, direction, neighbour, candidateNumber;
+    int candidates[4];
+    std::vector<char> visited;
+    std::vector<int> stack;
+    visited.assign(this->cellColumns() * this->cellRows(), 0);
+    visited[0] = 1;
+    this->tiles[this->tileOfCell(0)] = '.';
+    stack.push_back(0);
+    while (!stack.empty()) {
+        cell = stack.back();
+        candidateNumber = 0;
+        for (direction = 0; direction < 4; direction++) {
+            neighbour = this->neighbouringCell(cell, direction);
+            if (neighbour >= 0 && !visited[neighbour]) {
+                candidates[candidateNumber++] = neighbour;
+            }
+        }
+        if (candidateNumber == 0) {
+            stack.pop_back();
+            continue;
+        }
+        neighbour = candidates[this->randomBelow(candidateNumber)];
+        this->connectCells(cell, neighbour);
+        visited[neighbour] = 1;
+        stack.push_back(neighbour);
+    }
+}
+
+/**
+ * Carves a perfect maze by randomised Prim's algorithm.
+ *
+ * The maze grows from its first cell, each time by a random cell on its
+ * frontier. Its mazes have many short dead ends.
+ */
+void MazeGenerator::carvePrim() {
+    int cell, direction, neighbour, candidateNumber, frontierIndex;
+    int candidates[4];
+    std::vector<char> status;
+    std::vector<int> frontier;
+    /* Cells are unseen (0), on the frontier (1), or in the maze (2). */
+    status.assign(this->cellColumns() * this->cellRows(), 0);
+    cell = 0;
+    this->tiles[this->tileOfCell(cell)] = '.';
+    do {
+        status[cell] = 2;
+        for (direction = 0; direction < 4; direction++) {
+            neighbour = this->neighbouringCell(cell, direction);
+            if (neighbour >= 0 && status[neighbour] == 0) {
+                status[neighbour] = 1;
+                frontier.push_back(neighbour);
+            }
+        }
+        if (frontier.empty()) {
+            break;
+        }
+        frontierIndex = this->randomBelow((int)frontier.size());
+        cell = frontier[frontierIndex];
+        frontier[frontierIndex] = frontier.back();
+        frontier.pop_back();
+        candidateNumber = 0;
+        for (direction = 0; direction < 4; direction++) {
+            neighbour = this->neighbouringCell(cell, direction);
+            if (neighbour >= 0 && status[neighbour] == 2) {
+                candidates[candidateNumber++] = neighbour;
+            }
+        }
+        this->connectCells(cell, candidates[this->randomBelow(candidateNumber)]);
+    } while (true);
+}
+
+/**
+ * Finds the representative of a cell's set, halving the path to it.
+ *
+ * @param sets The disjoint-set forest, by parent.
+ * @param cell The index of the cell.
+ * @return The index of the representative cell.
+ */
+int MazeGenerator::findSet(std::vector<int> *sets, int cell) {
+    while ((*sets)[cell] != cell) {
+        (*sets)[cell] = (*sets)[(*sets)[cell]];
+        cell = (*sets)[cell];
+    }
+    return cell;
+}
+
+/**
+ * Carves open rooms, joined by a perfect maze of corridors.
+ *
+ * Rooms are placed at random, without touching one another. The corridors
+ * are carved by randomised Kruskal's algorithm, for which each room already
+ * counts as connected; every room is thus reachable, by a single corridor per
+ * room exit.
+ */
+void MazeGenerator::carveRoomsAndCorridors() {
+    int cellNumber, attempt, roomWidth, roomHeight, roomX, roomY, x, y, wallIndex, swapIndex, cell, neighbour;
+    bool free;
+    std::vector<char> occupied;
+    std::vector<int> sets, walls;
+    cellNumber = this->cellColumns() * this->cellRows();
+    occupied.assign(cellNumber, 0);
+    sets.resize(cellNumber);
+    for (cell = 0; cell < cellNumber; cell++) {
+        sets[cell] = cell;
+    }
+    for (attempt = 0; attempt < cellNumber / CELLS_PER_ROOM; attempt++) {
+        roomWidth = ROOM_SIDE_MINIMUM + this->randomBelow(ROOM_SIDE_MAXIMUM - ROOM_SIDE_MINIMUM + 1);
+        roomHeight = ROOM_SIDE_MINIMUM + this->randomBelow(ROOM_SIDE_MAXIMUM - ROOM_SIDE_MINIMUM + 1);
+        if (roomWidth > this->cellColumns() || roomHeight > this->cellRows()) {
+            continue;
+        }
+        roomX = this->randomBelow(this->cellColumns() - roomWidth + 1);
+        roomY = this->randomBelow(this->cellRows() - roomHeight + 1);
+        free = true;
+        for (y = std::max(roomY - 1, 0); free && y < std::min(roomY + roomHeight + 1, this->cellRows()); y++) {
+            for (x = std::max(roomX - 1, 0); free && x < std::min(roomX + roomWidth + 1, this->cellColumns()); x++) {
+                free = !occupied[y * this->cellColumns() + x];
+            }
+        }
+        if (!free) {
+            continue;
+        }
+        for (y = roomY; y < roomY + roomHeight; y++) {
+            for (x = roomX; x < roomX + roomWidth; x++) {
+                cell = y * this->cellColumns() + x;
+                occupied[cell] = 1;
+                if (x > roomX) {
+                    this->connectCells(cell - 1, cell);
+                    sets[this->findSet(&sets, cell)] = this->findSet(&sets, cell - 1);
+                }
+                if (y > roomY) {
+                    this->connectCells(cell - this->cellColumns(), cell);
+                    sets[this->findSet(&sets, cell)] = this->findSet(&sets, cell - this->cellColumns());
+                }
+            }
+        }
+    }
+    /* Walls are encoded as cell * 2 + (0: right, 1: below). */
+    for (cell = 0; cell < cellNumber; cell++) {
+        if (this->neighbouringCell(cell, 1) >= 0) {
+            walls.push_back(cell * 2);
+        }
+        if (this->neighbouringCell(cell, 2) >= 0) {
+            walls.push_back(cell * 2 + 1);
+        }
+    }
+    for (wallIndex = (int)walls.size() - 1; wallIndex > 0; wallIndex--) {
+        swapIndex = this->randomBelow(wallIndex + 1);
+        std::swap(walls[wallIndex], walls[swapIndex]);
+    }
+    for (wallIndex = 0; wallIndex < (int)walls.size(); wallIndex++) {
+        cell = walls[wallIndex] / 2;
+        neighbour = this->neighbouringCell(cell, (walls[wallIndex] % 2 == 0 ? 1 : 2));
+        if (this->findSet(&sets, cell) != this->findSet(&sets, neighbour)) {
+            sets[this->findSet(&sets, neighbour)] = this->findSet(&sets, cell);
+            this->connectCells(cell, neighbour);
+        }
+    }
+}
+
+/**
+ * Computes the number of steps from a tile to every other tile.
+ *
+ * Pits are entered, but never left.
+ *
+ * @param source The index of the tile to measure from.
+ * @param stopAtGates Should gates be regarded as closed?
+ * @return The distance per tile, or -1 for tiles that cannot be reached.
+ */
+std::vector<int> MazeGenerator::tileDistances(int source, bool stopAtGates) const {
+    int tile, next, direction, head;
+    int offsets[4];
+    std::vector<int> distances, queue;
+    offsets[0] = -this->width, offsets[1] = 1, offsets[2] = this->width, offsets[3] = -1;
+    distances.assign(this->tiles.size(), -1);
+    distances[source] = 0;
+    queue.push_back(source);
+    for (head = 0; head < (int)queue.size(); head++) {
+        tile = queue[head];
+        if (this->tiles[tile] == '#' && tile != source) {
+            continue;
+        }
+        for (direction = 0; direction < 4; direction++) {
+            if ((direction == 1 && tile % this->width == this->width - 1) || (direction == 3 && tile % this->width == 0)) {
+                continue;
+            }
+            next = tile + offsets[direction];
+            if (next < 0 || next >= (int)this->tiles.size() || distances[next] >= 0 || this->tiles[next] == ' ' ||
+                    (stopAtGates && this->tiles[next] == '|')) {
+                continue;
+            }
+            distances[next] = distances[tile] + 1;
+            queue.push_back(next);
+        }
+    }
+    return distances;
+}
+
+/**
+ * Marks the tiles along a shortest path from the start to the goal.
+ *
+ * @param distances The distances of all tiles from the start.
+ * @return Per tile, whether it lies on the path.
+ */
+std::vector<char> MazeGenerator::solutionPath(const std::vector<int> &distances) const {
+    int tile, next, direction;
+    int offsets[4];
+    std::vector<char> path;
+    offsets[0] = -this->width, offsets[1] = 1, offsets[2] = this->width, offsets[3] = -1;
+    path.assign(this->tiles.size(), 0);
+    tile = this->goalTile;
+    path[tile] = 1;
+    next = tile;
+    while (distances[tile] > 0) {
+        for (direction = 0; direction < 4; direction++) {
+            next = tile + offsets[direction];
+            if (next >= 0 && next < (int)this->tiles.size() && distances[next] == distances[tile] - 1 &&
+                    std::abs(next % this->width - tile % this->width) <= 1) {
+                break;
+            }
+        }
+        tile = next;
+        path[tile] = 1;
+    }
+    return path;
+}
+
+/**
+ * Collects all tiles of the given type.
+ *
+ * @param tile The type of tile, as its input character.
+ * @param exclusions Optional. Per tile, whether to leave it out.
+ * @return The indices of the tiles.
+ */
+std::vector<int> MazeGenerator::tilesOfType(char tile, const std::vector<char> *exclusions) const {
+    int tileIndex;
+    std::vector<int> found;
+    for (tileIndex = 0; tileIndex < (int)this->tiles.size(); tileIndex++) {
+        if (this->tiles[tileIndex] == tile && (exclusions == nullptr || !(*exclusions)[tileIndex])) {
+            found.push_back(tileIndex);
+        }
+    }
+    return found;
+}
+
+/**
+ * Draws a number of distinct tiles from the candidates.
+ *
+ * @param candidates The tiles to draw from.
+ * @param number The number of tiles to draw. At most the number of candidates.
+ * @return The drawn tiles.
+ */
+std::vector<int> MazeGenerator::sampleTiles(std::vector<int> candidates, int number) {
+    int drawIndex;
+    for (drawIndex = 0; drawIndex < number; drawIndex++) {
+        std::swap(candidates[drawIndex], candidates[drawIndex + this->randomBelow((int)candidates.size() - drawIndex)]);
+    }
+    candidates.resize(number);
+    return candidates;
+}
+
+/**
+ * Obtains the number of tiles a density amounts to.
+ *
+ * @param density The fraction of open tiles.
+ * @param openTileNumber The number of open tiles of the maze.
+ * @param candidateNumber The number of tiles eligible. Bounds the result.
+ * @return The number of tiles.
+ */
+int MazeGenerator::tileNumberOfDensity(double density, int openTileNumber, int candidateNumber) {
+    int number;
+    number = (int)std::lround(density * openTileNumber);
+    return (number < candidateNumber ? number : candidateNumber);
+}
+
+/**
+ * Turns a number of random candidate tiles into the given type.
+ *
+ * @param candidates The tiles to choose from.
+ * @param number The number of tiles to change.
+ * @param tile The type to give them, as its input character.
+ */
+void MazeGenerator::placeTiles(const std::vector<int> &candidates, int number, char tile) {
+    int drawIndex;
+    std::vector<int> drawn;
+    drawn = this->sampleTiles(candidates, number);
+    for (drawIndex = 0; drawIndex < number; drawIndex++) {
+        this->tiles[drawn[drawIndex]] = tile;
+    }
+}
+
+/**
+ * Places the start, the goal, and the special tiles in the carved maze.
+ *
+ * The goal is placed as far from the start as possible. Special tiles are
+ * placed such that the maze can always be solved: pits and warps stay off the
+ * shortest path to the goal, gates lie on it, and at least one lever can be
+ * reached before passing any gate.
+ */
+void MazeGenerator::placeSpecialTiles() {
+    int tileIndex, openTileNumber, leverNumber, nearestGate;
+    std::vector<int> distances, startDistances, candidates, gates;
+    std::vector<char> path;
+    this->startTile = this->tileOfCell(0);
+    distances = this->tileDistances(this->startTile, false);
+    this->goalTile = this->startTile;
+    for (tileIndex = 0; tileIndex < (int)this->tiles.size(); tileIndex++) {
+        if (distances[tileIndex] > distances[this->goalTile]) {
+            this->goalTile = tileIndex;
+        }
+    }
+    this->tiles[this->startTile] = '*';
+    this->tiles[this->goalTile] = '1';
+    path = this->solutionPath(distances);
+    startDistances = distances;
+    openTileNumber = (int)this->tilesOfType('.').size();
+    candidates = this->tilesOfType('.', &path);
+    this->placeTiles(candidates, MazeGenerator::tileNumberOfDensity(this->pitDensity, openTileNumber,
+            (int)candidates.size()), '#');
+    candidates = this->tilesOfType('.', &path);
+    this->placeTiles(candidates, MazeGenerator::tileNumberOfDensity(this->warpDensity, openTileNumber,
+            (int)candidates.size()), '0');
+    for (tileIndex = 0; tileIndex < (int)path.size(); tileIndex++) {
+        path[tileIndex] = !path[tileIndex];
+    }
+    candidates = this->tilesOfType('.', &path);
+    this->placeTiles(candidates, MazeGenerator::tileNumberOfDensity(this->gateDensity, openTileNumber,
+            (int)candidates.size()), '|');
+    gates = this->tilesOfType('|');
+    if (!gates.empty() || this->leverDensity > 0.0) {
+        do {
+            distances = this->tileDistances(this->startTile, true);
+            candidates.clear();
+            for (tileIndex = 0; tileIndex < (int)this->tiles.size(); tileIndex++) {
+                if (this->tiles[tileIndex] == '.' && distances[tileIndex] >= 0) {
+                    candidates.push_back(tileIndex);
+                }
+            }
+            if (!candidates.empty() || gates.empty()) {
+                break;
+            }
+            /* No lever fits before the first gate, which could thus never open. */
+            nearestGate = 0;
+            for (tileIndex = 1; tileIndex < (int)gates.size(); tileIndex++) {
+                if (startDistances[gates[tileIndex]] < startDistances[gates[nearestGate]]) {
+                    nearestGate = tileIndex;
+                }
+            }
+            this->tiles[gates[nearestGate]] = '.';
+            gates.erase(gates.begin() + nearestGate);
+        } while (true);
+        leverNumber = MazeGenerator::tileNumberOfDensity(this->leverDensity, openTileNumber, (int)candidates.size());
+        if (!gates.empty() && leverNumber == 0) {
+            leverNumber = 1;
+        }
+        this->placeTiles(candidates, leverNumber, ':');
+    }
+    candidates = this->tilesOfType('.');
+    this->placeTiles(candidates, std::min(MazeGenerator::tileNumberOfDensity(this->snackDensity, openTileNumber,
+            (int)candidates.size()), (int)MazeLayout::MAXIMUM_SNACKS), '%');
+}
+
+/**
+ * Constructs a maze generator.
+ *
+ * Mazes are laid out on a grid of about the requested number of tiles, whose
+ * sides are odd, so that cells and the walls between them alternate. No
+ * special tiles are placed until densities are set for them.
+ *
+ * @param algorithm The algorithm to carve mazes with.
+ * @param cells The approximate number of tiles of the mazes.
+ * @param seed The seed that determines the mazes.
+ */
+MazeGenerator::MazeGenerator(Algorithms algorithm, int cells, uint64_t seed) {
+    int side;
+    cells = std::max((int)MINIMUM_CELLS, std::min(cells, (int)MAXIMUM_CELLS));
+    side = (int)std::sqrt((double)cells);
+    this->algorithm = algorithm;
+    this->width = std::max(3, side | 1);
+    this->height = std::max(3, (cells / this->width) | 1);
+    this->seed = seed;
+    this->setDensities(0.0, 0.0, 0.0, 0.0, 0.0);
+    this->startTile = this->goalTile = 0;
+}
+
+/**
+ * Determines whether a maze identifier specifies a generated maze.
+ *
+ * @param identifier The maze identifier.
+ * @return The question's answer.
+ */
+bool MazeGenerator::isSpecification(const std::string &identifier) {
+    return identifier.compare(0, std::string(SPECIFICATION_PREFIX).size(), SPECIFICATION_PREFIX) == 0;
+}
+
+/**
+ * Configures a generator from a specification.
+ *
+ * Specifications are of the form 'generate:<algorithm>:<cells>:<seed>',
+ * optionally followed by fields ':<tiles>=<density>'. Algorithms are
+ * 'backtracker', 'prim' and 'rooms'; tiles are 'pits', 'warps', 'levers',
+ * 'gates' and 'snacks'. For instance, 'generate:prim:1000000:7:pits=0.01'.
+ *
+ * @param specification The specification.
+ * @param generator Output parameter. The generator, left untouched if the
+ *      specification is invalid.
+ * @return Whether the specification was valid.
+ */
+bool MazeGenerator::fromSpecification(const std::string &specification, MazeGenerator *generator) {
+    int fieldIndex;
+    long cells;
+    unsigned long long seed;
+    char *end;
+    std::string field;
+    std::vector<std::string> fields;
+    Algorithms algorithm;
+    MazeGenerator configured;
+    std::istringstream stream(specification);
+    while (std::getline(stream, field, ':')) {
+        fields.push_back(field);
+    }
+    if (!MazeGenerator::isSpecification(specification) || fields.size() < 4) {
+        printf("[MazeGenerator] Error: Specification '%s' lacks fields. Ignoring.\n", specification.c_str());
+        return false;
+    }
+    if (!MazeGenerator::algorithmFromName(fields[1], &algorithm)) {
+        printf("[MazeGenerator] Error: Unknown algorithm '%s'. Ignoring.\n", fields[1].c_str());
+        return false;
+    }
+    cells = strtol(fields[2].c_str(), &end, 10);
+    if (*end != '\0' || fields[2].empty() || cells < MINIMUM_CELLS || cells > MAXIMUM_CELLS) {
+        printf("[MazeGenerator] Error: Invalid cell number '%s' (%d to %d). Ignoring.\n", fields[2].c_str(),
+                (int)MINIMUM_CELLS, (int)MAXIMUM_CELLS);
+        return false;
+    }
+    seed = strtoull(fields[3].c_str(), &end, 10);
+    if (*end != '\0' || fields[3].empty() || fields[3][0] == '-') {
+        printf("[MazeGenerator] Error: Invalid seed '%s'. Ignoring.\n", fields[3].c_str());
+        return false;
+    }
+    configured = MazeGenerator(algorithm, (int)cells, (uint64_t)seed);
+    for (fieldIndex = 4; fieldIndex < (int)fields.size(); fieldIndex++) {
+        if (!configured.densityFromField(fields[fieldIndex])) {
+            printf("[MazeGenerator] Error: Invalid density '%s'. Ignoring.\n", fields[fieldIndex].c_str());
+            return false;
+        }
+    }
+    *generator = configured;
+    return true;
+}
+
+/**
+ * Sets the densities of the special tiles.
+ *
+ * Each density is the fraction of the maze's open tiles to turn into the
+ * associated special tile. At most 63 snacks are placed.
+ *
+ * @param pits The density of pits.
+ * @param warps The density of warps.
+ * @param levers The density of levers.
+ * @param gates The density of gates.
+ * @param snacks The density of snacks.
+ */
+void MazeGenerator::setDensities(double pits, double warps, double levers, double gates, double snacks) {
+    this->pitDensity = pits;
+    this->warpDensity = warps;
+    this->leverDensity = levers;
+    this->gateDensity = gates;
+    this->snackDensity = snacks;
+}
+
+/**
+ * Generates the maze.
+ *
+ * Equal configurations always generate equal mazes.
+ */
+void MazeGenerator::generate() {
+    this->engine.seed(this->seed);
+    this->tiles.assign(this->width * this->height, ' ');
+    switch (this->algorithm) {
+        case Algorithms::Prim:
+            this->carvePrim();
+            break;
+        case Algorithms::RoomsAndCorridors:
+            this->carveRoomsAndCorridors();
+            break;
+        default:
+            this->carveRecursiveBacktracker();
+            break;
+    }
+    this->placeSpecialTiles();
+}
+
+/**
+ * Obtains the width of the generated maze.
+ *
+ * @return The maze's width.
+ */
+int MazeGenerator::getMazeWidth() const {
+    return this->width;
+}
+
+/**
+ * Obtains the height of the generated maze.
+ *
+ * @return The maze's height.
+ */
+int MazeGenerator::getMazeHeight() const {
+    return this->height;
+}
+
+/**
+ * Obtains a tile of the generated maze.
+ *
+ * @param x The tile's horizontal coordinate.
+ * @param y The tile's vertical coordinate.
+ * @return The tile, as its input character.
+ */
+char MazeGenerator::getTile(int x, int y) const {
+    return this->tiles[y * this->width + x];
+}
+
+/**
+ * Writes the generated maze to a file.
+ *
+ * Paths ending in '.mzb' get a binary maze file (see MazeFile), with the
+ * default movement probabilities; all others the plain text input format.
+ *
+ * @param outputFile The path of the file to write.
+ * @return Whether the maze was written.
+ */
+bool MazeGenerator::writeMaze(const std::string &outputFile) const {
+    int y, tileIndex;
+    std::vector<unsigned char> types;
+    if (MazeFile::isBinary(outputFile)) {
+        types.resize(this->tiles.size());
+        for (tileIndex = 0; tileIndex < (int)this->tiles.size(); tileIndex++) {
+            types[tileIndex] = (unsigned char)MazeLayout::typeFromInput(this->tiles[tileIndex]);
+        }
+        return MazeFile::write(outputFile, this->width, this->height, types.data(),
+                MazeLayout::defaultMoveProbabilities());
+    }
+    std::ofstream outputStream(outputFile);
+    if (!outputStream) {
+        printf("[MazeGenerator] Error: Could not open '%s' for writing. Ignoring.\n", outputFile.c_str());
+        return false;
+    }
+    outputStream << this->width << " " << this->height << "\n";
+    for (y = 0; y < this->height; y++) {
+        outputStream.write(&(this->tiles[y * this->width]), this->width);
+        outputStream << "\n";
+    }
+    return (bool)outputStream;
+}
\ No newline at end of file
@@ -0,0 +1,917 @@
+#include <fstream>
+#include <algorithm>
+#include <sstream>
+#include "Maze.hpp"
+#include "MazeLayout.hpp"
+#include "MazeGenerator.hpp"
+
+/**
+ * Associates an input character to a state's tile type.
+ *
+ * @param input The input character to associate a tile type to.
+ * @return The tile type.
+ */
+State::Types MazeLayout::typeFromInput(char input) {
+    switch (input) {
+        case '.':
+            return State::Types::path;
+        case '*':
+            return State::Types::start;
+        case '1':
+            return State::Types::goal;
+        case '0':
+            return State::Types::warp;
+        case ':':
+            return State::Types::lever;
+        case '|':
+            return State::Types::gate;
+        case '%':
+            return State::Types::snack;
+        case '#':
+            return State::Types::pit;
+        default:
+            return State::Types::none;
+    }
+}
+
+/**
+ * Obtains the relative movement probabilities mazes have by default.
+ *
+ * @return The probabilities, ordered clockwise, starting in the intended
+ *      direction.
+ */
+std::tuple<double, double, double, double> MazeLayout::defaultMoveProbabilities() {
+    return std::make_tuple(0.8, 0.1, 0.0, 0.1);
+}
+
+/**
+ * Obtains the reward of arriving in a tile of the given type.
+ *
+ * @param type The tile type, as seen by the arriving player.
+ * @return The associated reward.
+ */
+double MazeLayout::rewardOfType(State::Types type) {
+    switch (type) {
+        case State::Types::goal:
+            return Maze::GOAL_REWARD;
+        case State::Types::snack:
+            return Maze::POSITIVE_REWARD;
+        case State::Types::pit:
+            return Maze::NEGATIVE_REWARD;
+        default:
+            return Maze::NORMAL_REWARD;
+    }
+}
+
+/**
+ * Sets this maze's dimensions by reading from input.
+ *
+ * Two arguments are expected. The first is width, the second height.
+ */
+void MazeLayout::getMazeDimensionsFromInput() {
+    scanf("%d %d", &(this->width), &(this->height));
+}
+
+/**
+ * Sets this maze's dimensions by reading from a plain text file.
+ *
+ * Two arguments are expected. The first is width, the second height.
+ *
+ * @param inputStream The input stream for the text file.
+ */
+void MazeLayout::getMazeDimensionsFromFile(std::ifstream *inputStream) {
+    int w, h;
+    std::string line;
+    std::getline(*inputStream, line);
+    std::istringstream stream(line);
+    if (!(stream >> w >> h)) {
+        printf("[MazeLayout] Error: Could not read width and height. Aborting.\n");
+    } else {
+        this->width = w;
+        this->height = h;
+    }
+}
+
+/**
+ * Appends a cell to the layout.
+ *
+ * Cells are appended row by row, so that their coordinates follow from their
+ * indices. Empty cells are appended too; they are only left out once the
+ * layout's states are indexed.
+ *
+ * @param type The cell's tile type.
+ */
+void MazeLayout::addCell(State::Types type) {
+    this->ownedStateTypes.push_back((unsigned char)type);
+}
+
+/**
+ * Sets this maze's states by reading from input.
+ *
+ * States are represented by characters. For an overview of all valid
+ * characters, we recommend consulting this source file's header. Spaces entail
+ * no state. Newlines start new rows of the maze.
+ *   This method assumes the dimensions of the maze are already configured.
+ */
+void MazeLayout::getMazeStatesFromInput() {
+    int x, y;
+    char input;
+    getchar();
+    for (y = 0; y < this->height; y++) {
+        for (x = 0; x < (this->width + 1); x++) {
+            scanf("%c", &input);
+            if (x != this->width) {
+                this->addCell(MazeLayout::typeFromInput(input));
+            }
+        }
+    }
+}
+
+/**
+ * Sets this maze's states by reading from a plain text file.
+ *
+ * States are represented by characters. For an overview of all valid
+ * characters, we recommend consulting this source file's header. Spaces entail
+ * no state. Newlines start new rows of the maze.
+ *   This method assumes the dimensions of the maze are already configured.
+ *
+ * @param inputStream The input stream for the text file.
+ */
+void MazeLayout::getMazeStatesFromFile(std::ifstream *inputStream) {
+    int x, y;
+    char input;
+    for (y = 0; y < this->height; y++) {
+        for (x = 0; x < (this->width + 1); x++) {
+            input = inputStream->get();
+            if (x != this->width) {
+                this->addCell(MazeLayout::typeFromInput(input));
+            }
+        }
+    }
+}
+
+/**
+ * Sets this maze's dimensions and states by generating them.
+ *
+ * The generated tiles are added directly, without an intermediate file.
+ *
+ * @param specification The generator specification, see MazeGenerator.
+ */
+void MazeLayout::getMazeFromGenerator(const std::string& specification) {
+    int x, y;
+    MazeGenerator generator;
+    if (!MazeGenerator::fromSpecification(specification, &generator)) {
+        printf("[MazeLayout] Error: Could not generate maze '%s'. Aborting.\n", specification.c_str());
+        exit(EXIT_FAILURE);
+    }
+    generator.generate();
+    this->width = generator.getMazeWidth();
+    this->height = generator.getMazeHeight();
+    this->ownedStateTypes.reserve(this->width * this->height);
+    for (y = 0; y < this->height; y++) {
+        for (x = 0; x < this->width; x++) {
+            this->addCell(MazeLayout::typeFromInput(generator.getTile(x, y)));
+        }
+    }
+}
+
+/**
+ * Sets this maze's dimensions, states and movement probabilities by mapping a
+ * binary maze file.
+ *
+ * The tile types are used straight from the mapping, rather than copied.
+ *
+ * @param inputFile The relative path to the binary maze file.
+ */
+void MazeLayout::getMazeFromBinaryFile(const std::string& inputFile) {
+    this->file = new MazeFile();
+    if (!this->file->open(inputFile)) {
+        printf("[MazeLayout] Error: Could not load maze '%s'. Aborting.\n", inputFile.c_str());
+        exit(EXIT_FAILURE);
+    }
+    this->width = this->file->getMazeWidth();
+    this->height = this->file->getMazeHeight();
+    this->moveProbabilities = this->file->getMoveProbabilities();
+    this->stateTypes = this->file->getTypes();
+}
+
+/**
+ * Determines whether a player could stand in a cell, ignoring reachability.
+ *
+ * @param x The cell's horizontal coordinate.
+ * @param y The cell's vertical coordinate.
+ * @param gatesOpen Should the gates be regarded as open?
+ * @return The question's answer.
+ */
+bool MazeLayout::cellIsPassable(int x, int y, bool gatesOpen) const {
+    State::Types t;
+    if (this->moveIsOutOfBounds(x, y)) {
+        return false;
+    }
+    t = (State::Types)this->stateTypes[y * this->width + x];
+    return (t != State::Types::none) && (t != State::Types::gate || gatesOpen);
+}
+
+/**
+ * Marks the cells a player can reach, starting from the given cells.
+ *
+ * Moves go to any passable neighbour, as every direction can be intended.
+ * Terminal cells end the search. Arriving in a warp may take the player next
+ * to any goal, so a reachable warp makes all goals and their warp
+ * destinations reachable too; those are found the way Maze finds them.
+ *
+ * @param seeds The cells to start from.
+ * @param gatesOpen Should the gates be regarded as open?
+ * @param reached Input/output parameter. Per cell, whether it is reachable.
+ *      Cells already marked are not explored again.
+ * @return The levers among the newly reached cells.
+ */
+std::vector<int> MazeLayout::markReachableCells(const std::vector<int>& seeds, bool gatesOpen,
+        std::vector<char> *reached) const {
+    int cell, x, y, direction, goalIndex, deltas[Maze::ACTION_NUMBER][2] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+    bool warpsFollowed;
+    State::Types t;
+    std::vector<int> frontier, levers, goals;
+    warpsFollowed = false;
+    for (cell = 0; cell < this->getCellNumber(); cell++) {
+        if ((State::Types)this->stateTypes[cell] == State::Types::goal) {
+            goals.push_back(cell);
+        }
+    }
+    frontier = seeds;
+    while (!frontier.empty()) {
+        cell = frontier.back();
+        frontier.pop_back();
+        if ((*reached)[cell]) {
+            continue;
+        }
+        (*reached)[cell] = 1;
+        t = (State::Types)this->stateTypes[cell];
+        if (t == State::Types::goal || t == State::Types::pit) {
+            continue;
+        }
+        if (t == State::Types::lever) {
+            levers.push_back(cell);
+        }
+        x = cell % this->width;
+        y = cell / this->width;
+        for (direction = 0; direction < Maze::ACTION_NUMBER; direction++) {
+            if (this->cellIsPassable(x + deltas[direction][0], y + deltas[direction][1], gatesOpen)) {
+                frontier.push_back(cell + deltas[direction][1] * this->width + deltas[direction][0]);
+            }
+        }
+        if (t == State::Types::warp && !warpsFollowed) {
+            warpsFollowed = true;
+            for (goalIndex = 0; goalIndex < (int)goals.size(); goalIndex++) {
+                frontier.push_back(goals[goalIndex]);
+                x = goals[goalIndex] % this->width;
+                y = goals[goalIndex] / this->width;
+                for (direction = 0; direction < Maze::ACTION_NUMBER; direction++) {
+                    if (this->cellIsPassable(x + deltas[direction][0], y + deltas[direction][1], gatesOpen)) {
+                        frontier.push_back(goals[goalIndex] + deltas[direction][1] * this->width +
+                                deltas[direction][0]);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    return levers;
+}
+
+/**
+ * Indexes the maze's reachable cells compactly, as its states.
+ *
+ * Cells are reachable from the designated starting cells, or from any cell a
+ * player may start in if there are none. The search is run with the gates
+ * closed first; once a lever turns out to be reachable, it is continued from
+ * the levers with the gates open. Walls, and regions no player can get to
+ * (such as those behind gates no reachable lever opens), do not become
+ * states. States keep the cells' row by row order, so that the mapping is
+ * monotone both ways.
+ */
+void MazeLayout::buildStateIndex() {
+    int cellIndex;
+    State::Types t;
+    std::vector<int> seeds, levers;
+    std::vector<char> reachedClosed, reachedOpen;
+    for (cellIndex = 0; cellIndex < this->getCellNumber(); cellIndex++) {
+        if ((State::Types)this->stateTypes[cellIndex] == State::Types::start) {
+            seeds.push_back(cellIndex);
+        }
+    }
+    if (seeds.empty()) {
+        /* Players may start at any nontrivial cell. */
+        for (cellIndex = 0; cellIndex < this->getCellNumber(); cellIndex++) {
+            t = (State::Types)this->stateTypes[cellIndex];
+            if (t != State::Types::none && t != State::Types::gate && t != State::Types::goal &&
+                    t != State::Types::pit) {
+                seeds.push_back(cellIndex);
+            }
+        }
+    }
+    reachedClosed.assign((size_t)this->getCellNumber(), 0);
+    levers = this->markReachableCells(seeds, false, &reachedClosed);
+    if (!levers.empty()) {
+        reachedOpen.assign((size_t)this->getCellNumber(), 0);
+        this->markReachableCells(levers, true, &reachedOpen);
+    }
+    this->statesOfCells.assign((size_t)this->getCellNumber(), -1);
+    this->cellsOfStates.clear();
+    for (cellIndex = 0; cellIndex < this->getCellNumber(); cellIndex++) {
+        if (reachedClosed[cellIndex] || (!reachedOpen.empty() && reachedOpen[cellIndex])) {
+            this->statesOfCells[cellIndex] = (int)this->cellsOfStates.size();
+            this->cellsOfStates.push_back(cellIndex);
+        }
+    }
+}
+
+/**
+ * Among all this maze's states, stores those states that are special.
+ *
+ * A state is deemed special if it is a starting tile, a gate, a goal, or a
+ * snack. Snacks are numbered in order of appearance, so that whether each one
+ * was eaten fits a single bit of the maze's dynamics.
+ */
+void MazeLayout::getMazeSpecialStates() {
+    int i;
+    for (i = 0; i < this->getStateNumber(); i++) {
+        switch (this->getStateType(i)) {
+            case State::Types::start:
+                this->startingStates.push_back(i);
+                break;
+            case State::Types::gate:
+                this->gateStates.push_back(i);
+                break;
+            case State::Types::goal:
+                this->goalStates.push_back(i);
+                break;
+            case State::Types::snack:
+                this->snackStates.push_back(i);
+                break;
+            default:
+                break;
+        }
+    }
+    if ((int)this->snackStates.size() > MAXIMUM_SNACKS) {
+        printf("[MazeLayout] Error: More than %d snacks. Aborting.\n", MAXIMUM_SNACKS);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Reads the special states from the binary file, where they are precomputed.
+ *
+ * The file lists cells, which are translated to states; unreachable ones are
+ * left out. Since the translation is monotone, the lists remain in increasing
+ * order.
+ */
+void MazeLayout::getMazeSpecialStatesFromBinaryFile() {
+    int listIndex, count, entryIndex, stateIndex;
+    const int32_t *cells;
+    std::vector<int> *lists[MazeFile::SPECIAL_STATE_LISTS] = {&(this->startingStates), &(this->gateStates),
+            &(this->goalStates), &(this->snackStates)};
+    for (listIndex = 0; listIndex < MazeFile::SPECIAL_STATE_LISTS; listIndex++) {
+        cells = this->file->getSpecialStates((MazeFile::SpecialStates)listIndex, &count);
+        for (entryIndex = 0; entryIndex < count; entryIndex++) {
+            stateIndex = this->getStateOfCell(cells[entryIndex]);
+            if (stateIndex >= 0) {
+                lists[listIndex]->push_back(stateIndex);
+            }
+        }
+    }
+    if ((int)this->snackStates.size() > MAXIMUM_SNACKS) {
+        printf("[MazeLayout] Error: More than %d snacks. Aborting.\n", MAXIMUM_SNACKS);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Collects the maze's nontrivial states, with its gates either open or closed.
+ *
+ * A state is nontrivial if it is neither terminal nor intraversible.
+ *
+ * @param gatesOpen Should the gates be regarded as open?
+ */
+void MazeLayout::buildNontrivialStates(bool gatesOpen) {
+    int stateIndex;
+    this->nontrivialStates[gatesOpen].clear();
+    for (stateIndex = 0; stateIndex < this->getStateNumber(); stateIndex++) {
+        if (!this->stateIsTerminal(stateIndex) && !this->stateIsIntraversible(stateIndex, gatesOpen)) {
+            this->nontrivialStates[gatesOpen].push_back(stateIndex);
+        }
+    }
+}
+
+/**
+ * Builds the alias table from which actual rotations are drawn.
+ */
+void MazeLayout::buildRotationTable() {
+    int rotation;
+    double probabilities[Maze::ACTION_NUMBER];
+    for (rotation = 0; rotation < Maze::ACTION_NUMBER; rotation++) {
+        probabilities[rotation] = this->getActionProbability(rotation);
+    }
+    this->rotationTable.assign(1, Maze::ACTION_NUMBER);
+    this->rotationTable.setDistribution(0, probabilities);
+}
+
+/**
+ * Given the coordinates of a movement's resulting state, determines validity.
+ *
+ * Notice that a state is deemed 'valid' when it resides within the maze's
+ * borders. It may still be invalid due to it being a wall or an intraversible
+ * tile.
+ *
+ * @param x The horizontal coordinate of the resulting state.
+ * @param y The vertical coordinate of the resulting state.
+ * @return The question's answer.
+ */
+bool MazeLayout::moveIsOutOfBounds(int x, int y) const {
+    return (x < 0 || x >= this->width) || (y < 0 || y >= this->height);
+}
+
+/**
+ * Computes the transitions of a single state under all of its actions.
+ *
+ * Per action, one outcome is stored for each relative rotation of the
+ * intended direction. Each outcome holds the resulting state's index, the
+ * probability of the rotation and the reward of arriving in the resulting
+ * state, assuming its snack (if any) has not been eaten yet. A move into a
+ * wall, a closed gate or out of bounds fails, leaving the player in place.
+ *
+ * @param stateIndex The index of the state to compute the transitions of.
+ * @param gatesOpen Should the gates be regarded as open?
+ */
+void MazeLayout::computeTransitions(int stateIndex, bool gatesOpen) {
+    int actionIndex, rotationIndex, direction, x, y, nextIndex, deltas[Maze::ACTION_NUMBER][2] = {{0, -1}, {1, 0},
+            {0, 1}, {-1, 0}};
+    Transition *outcome;
+    for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+        for (rotationIndex = 0; rotationIndex < Maze::ACTION_NUMBER; rotationIndex++) {
+            direction = (actionIndex + rotationIndex) % Maze::ACTION_NUMBER;
+            x = this->getStateX(stateIndex) + deltas[direction][0];
+            y = this->getStateY(stateIndex) + deltas[direction][1];
+            outcome = &(this->transitions[gatesOpen][(stateIndex * Maze::ACTION_NUMBER + actionIndex) *
+                    Maze::ACTION_NUMBER + rotationIndex]);
+            nextIndex = this->moveIsOutOfBounds(x, y) ? -1 : this->indexFromCoordinates(x, y);
+            if (nextIndex < 0 || this->stateIsIntraversible(nextIndex, gatesOpen)) {
+                /* Maneuver failed. Remain in the current state. */
+                outcome->nextIndex = stateIndex;
+            } else {
+                outcome->nextIndex = nextIndex;
+            }
+            outcome->probability = this->getActionProbability(rotationIndex);
+            outcome->reward = MazeLayout::rewardOfType(this->getStateType(outcome->nextIndex));
+        }
+    }
+}
+
+/**
+ * Builds the maze-wide table of state-action transitions.
+ *
+ * The table is laid out flat, as [state][action][rotation]. It spares players
+ * from recomputing the maze's geometry on each step or backup.
+ *
+ * @param gatesOpen Should the gates be regarded as open?
+ */
+void MazeLayout::buildTransitionTable(bool gatesOpen) {
+    int stateIndex;
+    this->transitions[gatesOpen].resize((size_t)this->getStateNumber() * Maze::ACTION_NUMBER * Maze::ACTION_NUMBER);
+    for (stateIndex = 0; stateIndex < this->getStateNumber(); stateIndex++) {
+        this->computeTransitions(stateIndex, gatesOpen);
+    }
+}
+
+/**
+ * Builds the reverse of the transition table: per state, the states from which
+ * it can be reached with non-zero probability in a single step.
+ *
+ * The index is laid out compressed: the predecessors of all states are stored
+ * back to back, with per-state offsets into that list.
+ *
+ * @param gatesOpen Should the gates be regarded as open?
+ */
+void MazeLayout::buildPredecessorIndex(bool gatesOpen) {
+    int stateIndex, outcomeIndex, nextIndex, stateNumber, outcomeNumber;
+    std::vector<int> lastSeenBy, fill;
+    std::vector<int> &offsets = this->predecessorOffsets[gatesOpen];
+    const Transition *outcomes;
+    stateNumber = this->getStateNumber();
+    outcomeNumber = Maze::ACTION_NUMBER * Maze::ACTION_NUMBER;
+    lastSeenBy.assign(stateNumber, -1);
+    offsets.assign(stateNumber + 1, 0);
+    for (stateIndex = 0; stateIndex < stateNumber; stateIndex++) {
+        /* Count each distinct successor once per state. */
+        outcomes = &(this->transitions[gatesOpen][stateIndex * outcomeNumber]);
+        for (outcomeIndex = 0; outcomeIndex < outcomeNumber; outcomeIndex++) {
+            nextIndex = outcomes[outcomeIndex].nextIndex;
+            if (outcomes[outcomeIndex].probability > 0.0 && lastSeenBy[nextIndex] != stateIndex) {
+                lastSeenBy[nextIndex] = stateIndex;
+                offsets[nextIndex + 1]++;
+            }
+        }
+    }
+    for (stateIndex = 0; stateIndex < stateNumber; stateIndex++) {
+        offsets[stateIndex + 1] += offsets[stateIndex];
+    }
+    this->predecessors[gatesOpen].resize(offsets[stateNumber]);
+    fill.assign(offsets.begin(), offsets.end() - 1);
+    lastSeenBy.assign(stateNumber, -1);
+    for (stateIndex = 0; stateIndex < stateNumber; stateIndex++) {
+        outcomes = &(this->transitions[gatesOpen][stateIndex * outcomeNumber]);
+        for (outcomeIndex = 0; outcomeIndex < outcomeNumber; outcomeIndex++) {
+            nextIndex = outcomes[outcomeIndex].nextIndex;
+            if (outcomes[outcomeIndex].probability > 0.0 && lastSeenBy[nextIndex] != stateIndex) {
+                lastSeenBy[nextIndex] = stateIndex;
+                this->predecessors[gatesOpen][fill[nextIndex]++] = stateIndex;
+            }
+        }
+    }
+}
+
+/**
+ * Constructs a maze layout.
+ *
+ * This is the full-fledged constructor for maze layouts.
+ *   Layouts are either constructed from input, from a plain text file, from a
+ * binary file, or by a generator. By supplying an empty relative path string,
+ * the layout is construed from input; by supplying a generator specification
+ * (see MazeGenerator), it is generated; by supplying a path ending in '.mzb',
+ * it is mapped from the given binary file (see MazeFile); otherwise it is
+ * built from the given plain text file.
+ *   Four relative movement probabilities must be supplied, which are required
+ * to sum to one (certain probabilities may be zero). These represent the
+ * probabilities of moving in certain relative directions from the intended
+ * direction. They are listed in a clockwise manner, starting from the direction
+ * which was intended. Binary files carry probabilities of their own, which
+ * take precedence.
+ *   Only the cells players can reach become states, indexed compactly; walls
+ * and unreachable regions take up no room in any of the layout's tables, nor
+ * in those of its players.
+ *   A layout never changes after construction. Everything that depends on
+ * whether the gates are open is computed for both cases up front, so that any
+ * number of mazes, on any number of threads, may share a single layout.
+ *
+ * @param mps The relative movement probabilities, ordered clockwise, starting
+ *      in the intended direction.
+ * @param inputFile The relative path to the file from which to read, a
+ *      generator specification, or an empty string.
+ */
+MazeLayout::MazeLayout(std::tuple<double, double, double, double> mps, const std::string& inputFile) :
+        mazeIdentifier(inputFile) {
+    this->width = this->height = 0;
+    this->moveProbabilities = mps;
+    this->stateTypes = nullptr;
+    this->file = nullptr;
+    if (inputFile.empty()) {
+        /* Read from input. */
+        printf("Please input your self-built maze.\n");
+        printf("  Syntax (Step 1): Enter width, height (two integers greater than zero).\n");
+        printf("  Syntax (Step 2): Enter rows of maze, represented by characters, ending in ENTER.\n");
+        printf("  Legal characters:\n");
+        printf("    (.) Path, (*) Start, (1) Goal, (0) Warp, (:) Lever, (|) Gate, (%%) Snack, (#) Pit, ( ) Empty.\n");
+        this->getMazeDimensionsFromInput();
+        this->getMazeStatesFromInput();
+    } else if (MazeGenerator::isSpecification(inputFile)) {
+        /* Generate procedurally. */
+        this->getMazeFromGenerator(inputFile);
+    } else if (MazeFile::isBinary(inputFile)) {
+        /* Map a binary file. */
+        this->getMazeFromBinaryFile(inputFile);
+    } else {
+        /* Read from a plain text file. */
+        std::ifstream inputStream(inputFile);
+        this->getMazeDimensionsFromFile(&inputStream);
+        this->getMazeStatesFromFile(&inputStream);
+    }
+    if (this->file == nullptr) {
+        this->stateTypes = this->ownedStateTypes.data();
+    }
+    this->buildStateIndex();
+    if (this->file == nullptr) {
+        this->getMazeSpecialStates();
+    } else {
+        this->getMazeSpecialStatesFromBinaryFile();
+    }
+    this->buildRotationTable();
+    this->buildNontrivialStates(false);
+    this->buildNontrivialStates(true);
+    this->buildTransitionTable(false);
+    this->buildTransitionTable(true);
+    this->buildPredecessorIndex(false);
+    this->buildPredecessorIndex(true);
+}
+
+/**
+ * Destructs the maze layout, unmapping its binary file, if any.
+ */
+MazeLayout::~MazeLayout() {
+    delete this->file;
+}
+
+/**
+ * Constructs a maze layout.
+ *
+ * This is the shortened constructor for layouts, in which pre-specified
+ * relative movement probabilities are set. Only the input file is required.
+ *   For details on layout construction, see the full-fledged constructor above.
+ *
+ * @param inputFile The relative path to the file from which to read, a
+ *      generator specification, or an empty string.
+ */
+MazeLayout::MazeLayout(const std::string& inputFile) : MazeLayout(MazeLayout::defaultMoveProbabilities(),
+        inputFile) {}
+
+/**
+ * Obtains the state index associated with a state's coordinates.
+ *
+ * @param x The state's horizontal coordinate.
+ * @param y The state's vertical coordinate.
+ * @return The state's index, or -1 if the coordinates hold a wall.
+ */
+int MazeLayout::indexFromCoordinates(int x, int y) const {
+    return this->getStateOfCell(y * this->width + x);
+}
+
+/**
+ * Obtains the number of states of this layout.
+ *
+ * States are the traversable cells only, indexed densely, from zero up to
+ * (but excluding) this number.
+ *
+ * @return The number of states.
+ */
+int MazeLayout::getStateNumber() const {
+    return (int)this->cellsOfStates.size();
+}
+
+/**
+ * Obtains the number of cells of this layout, walls included.
+ *
+ * @return The number of cells, being the layout's width times its height.
+ */
+int MazeLayout::getCellNumber() const {
+    return this->width * this->height;
+}
+
+/**
+ * Obtains the cell a state occupies.
+ *
+ * Cells are indexed row by row, over the layout's full width and height.
+ *
+ * @param stateIndex The state's index.
+ * @return The cell's index.
+ */
+int MazeLayout::getCellOfState(int stateIndex) const {
+    return this->cellsOfStates[stateIndex];
+}
+
+/**
+ * Obtains the state occupying a cell.
+ *
+ * @param cellIndex The cell's index.
+ * @return The state's index, or -1 if the cell is a wall.
+ */
+int MazeLayout::getStateOfCell(int cellIndex) const {
+    return this->statesOfCells[cellIndex];
+}
+
+/**
+ * Obtains the horizontal coordinate of the state at the given index.
+ *
+ * @param stateIndex The state's index.
+ * @return The state's horizontal coordinate.
+ */
+int MazeLayout::getStateX(int stateIndex) const {
+    return this->cellsOfStates[stateIndex] % this->width;
+}
+
+/**
+ * Obtains the vertical coordinate of the state at the given index.
+ *
+ * @param stateIndex The state's index.
+ * @return The state's vertical coordinate.
+ */
+int MazeLayout::getStateY(int stateIndex) const {
+    return this->cellsOfStates[stateIndex] / this->width;
+}
+
+/**
+ * Obtains the tile type the state at the given index was laid out with.
+ *
+ * @param stateIndex The state's index.
+ * @return The state's tile type, regardless of any episode's dynamics.
+ */
+State::Types MazeLayout::getStateType(int stateIndex) const {
+    return (State::Types)this->stateTypes[this->cellsOfStates[stateIndex]];
+}
+
+/**
+ * Determines whether the state at the given index is a termination state.
+ *
+ * A state is a terminal state when it is a goal (positive case) or a pit
+ * (negative case).
+ *
+ * @param stateIndex The index of the state to evaluate.
+ * @return The question's answer.
+ */
+bool MazeLayout::stateIsTerminal(int stateIndex) const {
+    State::Types t;
+    t = this->getStateType(stateIndex);
+    return (t == State::Types::goal) || (t == State::Types::pit);
+}
+
+/**
+ * Determines whether the state at the given index is intraversible.
+ *
+ * A state is intraversible when it does not have a tile type, or when it is a
+ * gate that is still closed.
+ *
+ * @param stateIndex The index of the state to evaluate intraversibility for.
+ * @param gatesOpen Should the gates be regarded as open?
+ * @return The question's answer.
+ */
+bool MazeLayout::stateIsIntraversible(int stateIndex, bool gatesOpen) const {
+    State::Types t;
+    t = this->getStateType(stateIndex);
+    return (t == State::Types::none) || (t == State::Types::gate && !gatesOpen);
+}
+
+/**
+ * Obtains the number of the snack at the given state.
+ *
+ * @param stateIndex The state's index.
+ * @return The snack's number, or -1 if the state is no snack.
+ */
+int MazeLayout::getSnackNumber(int stateIndex) const {
+    std::vector<int>::const_iterator found;
+    found = std::lower_bound(this->snackStates.begin(), this->snackStates.end(), stateIndex);
+    if (found == this->snackStates.end() || *found != stateIndex) {
+        return -1;
+    }
+    return (int)(found - this->snackStates.begin());
+}
+
+/**
+ * Obtains the number of snacks laid out.
+ *
+ * @return The number of snacks.
+ */
+int MazeLayout::getSnackNumberTotal() const {
+    return (int)this->snackStates.size();
+}
+
+/**
+ * Determines whether the maze never changes, nor moves players around.
+ *
+ * This is the case if it has no warps, levers, gates or snacks. Its transition
+ * table then describes its dynamics exactly.
+ *
+ * @return The question's answer.
+ */
+bool MazeLayout::isStatic() const {
+    int stateIndex;
+    for (stateIndex = 0; stateIndex < this->getStateNumber(); stateIndex++) {
+        switch (this->getStateType(stateIndex)) {
+            case State::Types::warp:
+            case State::Types::lever:
+            case State::Types::gate:
+            case State::Types::snack:
+                return false;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+/**
+ * Obtains the designated starting states. These are all nontrivial.
+ *
+ * @return The starting states' indices. Empty if players start anywhere.
+ */
+const std::vector<int>& MazeLayout::getStartingStates() const {
+    return this->startingStates;
+}
+
+/**
+ * Obtains the goal states.
+ *
+ * @return The goal states' indices.
+ */
+const std::vector<int>& MazeLayout::getGoalStates() const {
+    return this->goalStates;
+}
+
+/**
+ * Obtains the nontrivial states, with the gates either open or closed.
+ *
+ * @param gatesOpen Should the gates be regarded as open?
+ * @return The nontrivial states' indices, in increasing order.
+ */
+const std::vector<int>& MazeLayout::getNontrivialStates(bool gatesOpen) const {
+    return this->nontrivialStates[gatesOpen];
+}
+
+/**
+ * Obtains the probability of performing an action given some action.
+ *
+ * @param relativeIndex The rotation from the action under consideration.
+ * @return The probability of performing the given action.
+ */
+double MazeLayout::getActionProbability(int relativeIndex) const {
+    switch (relativeIndex) {
+        case Maze::Rotations::Zero:
+            return std::get<0>(this->moveProbabilities);
+        case Maze::Rotations::Quarter:
+            return std::get<1>(this->moveProbabilities);
+        case Maze::Rotations::Half:
+            return std::get<2>(this->moveProbabilities);
+        default:
+            return std::get<3>(this->moveProbabilities);
+    }
+}
+
+/**
+ * Draws the rotation from the intended direction which will actually occur.
+ *
+ * The draw takes constant time through the layout's alias table, and only
+ * touches the calling thread's random stream.
+ *
+ * @return The rotation that will be executed in actuality.
+ */
+int MazeLayout::sampleRotation() const {
+    return this->rotationTable.sample(0);
+}
+
+/**
+ * Draws the rotation from the intended direction which will actually occur,
+ * given a uniform value drawn beforehand.
+ *
+ * @param value A random value between zero (inclusive) and one (exclusive).
+ * @return The rotation that will be executed in actuality.
+ */
+int MazeLayout::sampleRotation(double value) const {
+    return this->rotationTable.sample(0, value);
+}
+
+/**
+ * Obtains the precomputed outcomes of performing an action in a state.
+ *
+ * The returned view holds one transition per relative rotation of the action,
+ * ordered clockwise and starting in the intended direction. Its rewards assume
+ * that no snack has been eaten.
+ *
+ * @param stateIndex The index of the state from which the action is performed.
+ * @param action The index of the action to execute.
+ * @param gatesOpen Should the gates be regarded as open?
+ * @return The action's possible outcomes.
+ */
+const MazeLayout::Transition* MazeLayout::getTransitions(int stateIndex, int action, bool gatesOpen) const {
+    return &(this->transitions[gatesOpen][(stateIndex * Maze::ACTION_NUMBER + action) * Maze::ACTION_NUMBER]);
+}
+
+/**
+ * Obtains the states from which the given state can be reached in one step.
+ *
+ * @param stateIndex The index of the state to obtain the predecessors of.
+ * @param gatesOpen Should the gates be regarded as open?
+ * @param count Output parameter. The number of predecessors.
+ * @return The indices of the predecessors, each listed once.
+ */
+const int* MazeLayout::getPredecessors(int stateIndex, bool gatesOpen, int *count) const {
+    *count = this->predecessorOffsets[gatesOpen][stateIndex + 1] - this->predecessorOffsets[gatesOpen][stateIndex];
+    return this->predecessors[gatesOpen].data() + this->predecessorOffsets[gatesOpen][stateIndex];
+}
+
+/**
+ * Obtains the identifier of the layout.
+ *
+ * A maze identifier stores the file name from which the maze was constructed,
+ * if it was built from a plain text file. If composed from input, its maze
+ * identifier is simply a dash: '-'.
+ *
+ * @return The layout's identifier.
+ */
+std::string MazeLayout::getMazeIdentifier() const {
+    return this->mazeIdentifier;
+}
+
+/**
+ * Obtains the width of the layout.
+ *
+ * @return The layout's width.
+ */
+int MazeLayout::getMazeWidth() const {
+    return this->width;
+}
+
+/**
+ * Obtains the height of the layout.
+ *
+ * @return The layout's height.
+ */
+int MazeLayout::getMazeHeight() const {
+    return this->height;
+}
\ No newline at end of file
@@ -22,12 +22,7 @@ MonteCarloEveryVisitPlayer::~MonteCarloEveryVisitPlayer() = default;
  * Initalises the C (count) parameter of the algorithm.
  */
 void MonteCarloEveryVisitPlayer::initialiseC() {
-    int stateIndex, actionIndex;
-    for (stateIndex = 0; stateIndex < (int)this->stateValues.size(); stateIndex++) {
-        for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-            this->C[std::make_tuple(this->maze->getState(stateIndex), Maze::actionFromIndex(actionIndex))] = 0.0;
-        }
-    }
+    this->C.assign(this->maze->getStateNumber() * Maze::ACTION_NUMBER, 0.0);
 }
 
 /**
@@ -52,20 +47,24 @@ std::vector<double> MonteCarloEveryVisitPlayer::stateExplorationPolicy() {
  */
 void MonteCarloEveryVisitPlayer::initialiseExplorationPolicy() {
     int stateIndex;
-    for (stateIndex = 0; stateIndex < (int)this->stateValues.size(); stateIndex++) {
-        this->explorationPolicy[this->maze->getState(stateIndex)] = MonteCarloEveryVisitPlayer::stateExplorationPolicy();
+    std::vector<double> statePolicy;
+    statePolicy = MonteCarloEveryVisitPlayer::stateExplorationPolicy();
+    this->explorationPolicy.clear();
+    for (stateIndex = 0; stateIndex < this->maze->getStateNumber(); stateIndex++) {
+        this->explorationPolicy.insert(this->explorationPolicy.end(), statePolicy.begin(), statePolicy.end());
+        this->invalidateActionTable(stateIndex);
     }
 }
 
 /**
  * Obtains the action probability of doing the given action in this state.
  *
- * @param s The state in which the action is performed.
+ * @param s The index of the state in which the action is performed.
  * @param a The action to perform.
  * @return The performance probability.
  */
-double MonteCarloEveryVisitPlayer::actionProbability(State *s, Maze::Actions a) {
-    return this->explorationPolicy[s][a];
+double MonteCarloEveryVisitPlayer::actionProbability(int s, Maze::Actions a) {
+    return this->explorationPolicy[s * Maze::ACTION_NUMBER + a];
 }
 
 /**
@@ -73,8 +72,8 @@ double MonteCarloEveryVisitPlayer::actionProbability(State *s, Maze::Actions a)
  *
  * @return The initial state-action pair.
  */
-std::tuple<State*, Maze::Actions> MonteCarloEveryVisitPlayer::initialStateActionPair() {
-    State *startingState;
+std::tuple<int, Maze::Actions> MonteCarloEveryVisitPlayer::initialStateActionPair() {
+    int startingState;
     startingState = this->maze->getStartingState();
     return std::make_tuple(startingState, this->chooseAction(startingState));
 }
@@ -88,10 +87,10 @@ std::tuple<State*, Maze::Actions> MonteCarloEveryVisitPlayer::initialStateAction
  * We do so using a 'temperature' that gets cooled across time, not unlike
  * algorithms like simulated annealing.
  *
- * @param s The state for which to update the exploration policy.
+ * @param s The index of the state for which to update the exploration policy.
  * @param greedyAction The greedy action for this state.
  */
-void MonteCarloEveryVisitPlayer::updateExplorationPolicy(State *s, Maze::Actions greedyAction) {
+void MonteCarloEveryVisitPlayer::updateExplorationPolicy(int s, Maze::Actions greedyAction) {
     int actionIndex;
     double newActionProbability;
     Maze::Actions currentAction;
@@ -102,8 +101,9 @@ void MonteCarloEveryVisitPlayer::updateExplorationPolicy(State *s, Maze::Actions
         } else {
             newActionProbability = (this->temperature / Maze::ACTION_NUMBER);
         }
-        this->explorationPolicy[s][currentAction] = newActionProbability;
+        this->explorationPolicy[s * Maze::ACTION_NUMBER + currentAction] = newActionProbability;
     }
+    this->invalidateActionTable(s);
 }
 
 /**
@@ -112,9 +112,9 @@ void MonteCarloEveryVisitPlayer::updateExplorationPolicy(State *s, Maze::Actions
  * @param currentPair The current state-action pair.
  * @return The successor tuple.
  */
-std::tuple<State*, Maze::Actions> MonteCarloEveryVisitPlayer::nextStateActionPair(
-        std::tuple<State *, Maze::Actions> currentPair) {
-    std::tuple<State*, double> result;
+std::tuple<int, Maze::Actions> MonteCarloEveryVisitPlayer::nextStateActionPair(
+        std::tuple<int, Maze::Actions> currentPair) {
+    std::tuple<int, double> result;
     result = this->maze->getStateTransitionResult(std::get<0>(currentPair), std::get<1>(currentPair));
     this->rewards.push_back(std::get<1>(result));
     return std::make_tuple(std::get<0>(result), this->chooseAction(std::get<0>(result)));
@@ -125,11 +125,11 @@ std::tuple<State*, Maze::Actions> MonteCarloEveryVisitPlayer::nextStateActionPai
  *
  * @param startStateActionPair The initial state-action pair to depart from.
  */
-void MonteCarloEveryVisitPlayer::generateEpisode(std::tuple<State*, Maze::Actions> startStateActionPair) {
+void MonteCarloEveryVisitPlayer::generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) {
     int currentIteration, maximumIteration;
-    std::tuple<State*, Maze::Actions> stateActionPair;
+    std::tuple<int, Maze::Actions> stateActionPair;
     currentIteration = -1;
-    maximumIteration = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->stateValues.size());
+    maximumIteration = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->maze->getCellNumber());
     stateActionPair = this->initialStateActionPair();
     this->episode.push_back(stateActionPair);
     this->rewards.push_back(0.0);   /* First iteration has no reward. */
@@ -137,7 +137,7 @@ void MonteCarloEveryVisitPlayer::generateEpisode(std::tuple<State*, Maze::Action
         currentIteration++;
         stateActionPair = this->nextStateActionPair(stateActionPair);
         this->episode.push_back(stateActionPair);
-    } while (currentIteration < maximumIteration && !Maze::stateIsTerminal(std::get<0>(stateActionPair)));
+    } while (currentIteration < maximumIteration && !this->maze->stateIsTerminal(std::get<0>(stateActionPair)));
     this->maze->resetMaze();
 }
 
@@ -153,23 +153,22 @@ void MonteCarloEveryVisitPlayer::performInitialisation() {
  * Performs an iteration step of the Monte Carlo every-visit player.
  */
 void MonteCarloEveryVisitPlayer::performIteration() {
-    int iteration;
-    std::tuple<State*, Maze::Actions> stateActionPair;
-    State *state;
+    int iteration, pair, state;
+    std::tuple<int, Maze::Actions> stateActionPair;
     stateActionPair = this->initialStateActionPair();
     this->generateEpisode(stateActionPair);
     this->G = 0.0;
     this->W = 1.0;
     for (iteration = (int)this->episode.size() - 2; iteration >= 0; iteration--) {
         stateActionPair = this->episode[iteration];
+        pair = LearningPlayer::stateActionIndex(stateActionPair);
         this->G = this->discountFactor * this->G + this->rewards[iteration + 1];
-        this->C[stateActionPair] += this->W;
-        this->stateActionValues[stateActionPair] += (this->W / this->C[stateActionPair]) *
-                (this->G - this->stateActionValues[stateActionPair]);
+        this->C[pair] += this->W;
+        this->stateActionValues[pair] += (this->W / this->C[pair]) * (this->G - this->stateActionValues[pair]);
         state = std::get<0>(stateActionPair);
-        this->policy[state] = Player::actionAsActionProbabilityDistribution(this->greedyAction(state));
+        this->setStatePolicy(state, this->greedyAction(state));
         this->updateExplorationPolicy(state, this->greedyAction(state));
-        this->W *= this->explorationPolicy[state][std::get<1>(stateActionPair)];
+        this->W *= this->explorationPolicy[pair];
         if (this->W == 0.0) {
             break;
         }
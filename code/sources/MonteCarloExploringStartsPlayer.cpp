@@ -13,14 +13,10 @@ void MonteCarloExploringStartsPlayer::performInitialisation() {}
  * Recall our definition of non-triviality: A state is non-trivial if it is
  * neither a terminal state, nor an intraversible one.
  *
- * @return An arbitrary non-trivial state.
+ * @return The index of an arbitrary non-trivial state.
  */
-State *MonteCarloExploringStartsPlayer::randomState() {
-    State *s;
-    do {
-        s = this->maze->getState(RandomServices::discreteUniformSample((int)this->stateValues.size() - 1));
-    } while (Maze::stateIsTerminal(s) || Maze::stateIsIntraversible(s));
-    return s;
+int MonteCarloExploringStartsPlayer::randomState() {
+    return this->maze->getRandomNontrivialState();
 }
 
 /**
@@ -41,12 +37,10 @@ Maze::Actions MonteCarloExploringStartsPlayer::randomAction() {
  *
  * @return The arbitrary state-action tuple.
  */
-std::tuple<State*, Maze::Actions> MonteCarloExploringStartsPlayer::randomStateActionPair() {
-    State *s;
+std::tuple<int, Maze::Actions> MonteCarloExploringStartsPlayer::randomStateActionPair() {
+    int s;
     Maze::Actions a;
-    do {
-        s = this->randomState();
-    } while (Maze::stateIsTerminal(s) || Maze::stateIsIntraversible(s));
+    s = this->randomState();
     a = MonteCarloExploringStartsPlayer::randomAction();
     return std::make_tuple(s, a);
 }
@@ -60,7 +54,7 @@ std::tuple<State*, Maze::Actions> MonteCarloExploringStartsPlayer::randomStateAc
  *
  * @return The starting state-action pair.
  */
-std::tuple<State*, Maze::Actions> MonteCarloExploringStartsPlayer::initialStateActionPair() {
+std::tuple<int, Maze::Actions> MonteCarloExploringStartsPlayer::initialStateActionPair() {
     return this->randomStateActionPair();
 }
 
@@ -70,9 +64,9 @@ std::tuple<State*, Maze::Actions> MonteCarloExploringStartsPlayer::initialStateA
  * @param currentPair The current state-action pair to advance from.
  * @return The succeeding tuple of state and action.
  */
-std::tuple<State*, Maze::Actions> MonteCarloExploringStartsPlayer::nextStateActionPair(
-        std::tuple<State*, Maze::Actions> currentPair) {
-    std::tuple<State*, double> result;
+std::tuple<int, Maze::Actions> MonteCarloExploringStartsPlayer::nextStateActionPair(
+        std::tuple<int, Maze::Actions> currentPair) {
+    std::tuple<int, double> result;
     result = this->maze->getStateTransitionResult(std::get<0>(currentPair), std::get<1>(currentPair));
     this->rewards.push_back(std::get<1>(result));
     return std::make_tuple(std::get<0>(result), this->chooseAction(std::get<0>(result)));
@@ -83,11 +77,11 @@ std::tuple<State*, Maze::Actions> MonteCarloExploringStartsPlayer::nextStateActi
  *
  * @param startStateActionPair The initial state-action pair to depart from.
  */
-void MonteCarloExploringStartsPlayer::generateEpisode(std::tuple<State *, Maze::Actions> startStateActionPair) {
+void MonteCarloExploringStartsPlayer::generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) {
     int episodeIteration, episodeTimeout;
-    std::tuple<State*, Maze::Actions> currentStateActionPair;
+    std::tuple<int, Maze::Actions> currentStateActionPair;
     episodeIteration = -1;
-    episodeTimeout = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->stateValues.size());
+    episodeTimeout = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->maze->getCellNumber());
     currentStateActionPair = startStateActionPair;
     this->episode.push_back(currentStateActionPair);
     this->rewards.push_back(0.0);  /* At the onset, no rewards are obtained yet. */
@@ -95,59 +89,11 @@ void MonteCarloExploringStartsPlayer::generateEpisode(std::tuple<State *, Maze::
         episodeIteration++;
         currentStateActionPair = this->nextStateActionPair(currentStateActionPair);
         this->episode.push_back(currentStateActionPair);
-    } while (episodeIteration < episodeTimeout && !Maze::stateIsTerminal(std::get<0>(currentStateActionPair)));
+    } while (episodeIteration < episodeTimeout &&
+            !this->maze->stateIsTerminal(std::get<0>(currentStateActionPair)));
     this->maze->resetMaze();
 }
 
-/**
- * Computes a single component of the episode's returns.
- *
- * @param k The exponent to raise the gamma to.
- * @param rewardIndex The index of the current reward component.
- * @return The value of the component of the episode's returns.
- */
-double MonteCarloExploringStartsPlayer::episodeReturnComponent(int k, int rewardIndex) {
-    return std::pow(this->discountFactor, k) * this->rewards[rewardIndex];
-}
-
-/**
- * Computes the current episode's total returns.
- *
- * @param onsetIndex The index from which to start.
- * @return The episode's total returns.
- */
-double MonteCarloExploringStartsPlayer::episodeReturn(int onsetIndex) {
-    int i;
-    double episodeReturn;
-    episodeReturn = 0.0;
-    for (i = onsetIndex; i < (int)this->rewards.size(); i++) {
-        episodeReturn += this->episodeReturnComponent(i - onsetIndex, i);
-    }
-    return episodeReturn;
-}
-
-/**
- * Computes the average of the current episode's returns.
- *
- * @param stateActionPair THe state-action pair of which to get the mean return.
- * @return The state-action pair's average returns over episodes.
- */
-double MonteCarloExploringStartsPlayer::returnsAverage(std::tuple<State*, Maze::Actions> stateActionPair) {
-    int returnsIndex;
-    double average;
-    std::vector<double> stateActionReturns;
-    average = 0.0;
-    stateActionReturns = this->returns[stateActionPair];
-    for (returnsIndex = 0; returnsIndex < (int)stateActionReturns.size(); returnsIndex++) {
-        average += stateActionReturns[returnsIndex];
-    }
-    if (stateActionReturns.empty()) {
-        return 0.0;
-    } else {
-        return (average / (double)stateActionReturns.size());
-    }
-}
-
 /**
  * Constructs a Monte Carlo exploring starts player.
  *
@@ -168,20 +114,14 @@ MonteCarloExploringStartsPlayer::~MonteCarloExploringStartsPlayer() = default;
  */
 void MonteCarloExploringStartsPlayer::performIteration() {
     int episodeIteration;
-    std::tuple<State*, Maze::Actions> stateActionPair;
-    double episodeReturn;
+    std::tuple<int, Maze::Actions> stateActionPair;
     Maze::Actions greedyAction;
     this->generateEpisode(this->initialStateActionPair());
-    for (episodeIteration = 0; episodeIteration < (int)this->episode.size(); episodeIteration++) {
-        stateActionPair = this->episode[episodeIteration];
-        episodeReturn = this->episodeReturn(episodeIteration + 1);
-        this->returns[stateActionPair].push_back(episodeReturn);
-        this->stateActionValues[stateActionPair] = this->returnsAverage(stateActionPair);
-    }
+    this->addFirstVisitReturns();
     for (episodeIteration = 0; episodeIteration < (int)this->episode.size(); episodeIteration++) {
         stateActionPair = this->episode[episodeIteration];
         greedyAction = this->greedyAction(std::get<0>(stateActionPair));
-        this->policy[std::get<0>(stateActionPair)] = Player::actionAsActionProbabilityDistribution(greedyAction);
+        this->setStatePolicy(std::get<0>(stateActionPair), greedyAction);
     }
     this->addRewardsToTotalRewardPerEpisode();
     this->currentEpoch++;
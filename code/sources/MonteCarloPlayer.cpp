@@ -11,10 +11,60 @@
  *      policy?
  */
 MonteCarloPlayer::MonteCarloPlayer(Maze *m, double gamma, int T, bool initialiseStochastic) :
-        LearningPlayer(m, gamma, T, initialiseStochastic) {}
+        LearningPlayer(m, gamma, T, initialiseStochastic) {
+    this->returnCounts.assign(this->maze->getStateNumber() * Maze::ACTION_NUMBER, 0);
+    this->visitStamps.assign(this->maze->getStateNumber() * Maze::ACTION_NUMBER, -1);
+    this->firstVisitIndices.assign(this->maze->getStateNumber() * Maze::ACTION_NUMBER, 0);
+    this->currentVisitStamp = -1;
+}
 
 /**
  * Destructs the Monte Carlo player.
  */
 MonteCarloPlayer::~MonteCarloPlayer() = default;
 
+/**
+ * Folds an observed return into the mean return of a state-action pair.
+ *
+ * Only the number of returns seen so far is kept; the state-action value
+ * itself holds their running mean, so each update takes constant time.
+ *
+ * @param stateActionPair The state-action pair the return was observed for.
+ * @param sampleReturn The observed return.
+ */
+void MonteCarloPlayer::addReturn(std::tuple<int, Maze::Actions> stateActionPair, double sampleReturn) {
+    int pair;
+    pair = LearningPlayer::stateActionIndex(stateActionPair);
+    this->returnCounts[pair]++;
+    this->stateActionValues[pair] += (sampleReturn - this->stateActionValues[pair]) / this->returnCounts[pair];
+}
+
+/**
+ * Folds the returns of the current episode into the state-action values.
+ *
+ * Only the first visit of each state-action pair in the episode counts. First
+ * visits are found in a forward pass, stamping each pair with the current
+ * episode so that nothing needs clearing in between episodes. The returns are
+ * then accumulated in a single backward pass, in which the return of a step is
+ * the reward following it plus the discounted return of the next step.
+ */
+void MonteCarloPlayer::addFirstVisitReturns() {
+    int index, pair;
+    double G;
+    this->currentVisitStamp++;
+    for (index = 0; index < (int)this->episode.size(); index++) {
+        pair = LearningPlayer::stateActionIndex(this->episode[index]);
+        if (this->visitStamps[pair] != this->currentVisitStamp) {
+            this->visitStamps[pair] = this->currentVisitStamp;
+            this->firstVisitIndices[pair] = index;
+        }
+    }
+    G = 0.0;    /* The final pair is not followed by any reward. */
+    for (index = (int)this->episode.size() - 1; index >= 0; index--) {
+        pair = LearningPlayer::stateActionIndex(this->episode[index]);
+        if (this->firstVisitIndices[pair] == index) {
+            this->addReturn(this->episode[index], G);
+        }
+        G = this->rewards[index] + this->discountFactor * G;
+    }
+}
\ No newline at end of file
@@ -60,13 +60,120 @@ std::vector<double> Player::randomStatePolicy(bool stochastic) {
  * @param stochastic Should the configured policy be probabilistic?
  */
 void Player::initialisePolicy(bool stochastic) {
-    int i;
-    State* s;
-    std::vector<State> *states;
-    states = this->maze->getStates();
-    for (i = 0; i < (int)states->size(); i++) {
-        s = &(states->at(i));
-        this->policy[s] = Player::randomStatePolicy(stochastic);
+    this->initialisePolicy(stochastic, this->maze->getStateNumber());
+}
+
+/**
+ * Sets a random (possibly stochastic) policy over a given number of states.
+ *
+ * Players that plan over other states than the maze's positions use this.
+ *
+ * @param stochastic Should the configured policy be probabilistic?
+ * @param stateNumber The number of states to set a policy for.
+ */
+void Player::initialisePolicy(bool stochastic, int stateNumber) {
+    int s;
+    this->policy.resize(stateNumber * Maze::ACTION_NUMBER);
+    this->greedyActions.assign(stateNumber, -1);
+    this->implicitEpsilon = 0.0;
+    this->actionTable.assign(stateNumber, Maze::ACTION_NUMBER);
+    this->actionTableIsCurrent.assign(stateNumber, 0);
+    for (s = 0; s < stateNumber; s++) {
+        this->setStatePolicy(s, Player::randomStatePolicy(stochastic));
+    }
+}
+
+/**
+ * Overwrites the policy of a single state.
+ *
+ * @param s The index of the state to set the policy of.
+ * @param statePolicy The state's action probability distribution.
+ */
+void Player::setStatePolicy(int s, const std::vector<double> &statePolicy) {
+    int actionIndex;
+    this->greedyActions[s] = -1;
+    this->actionTableIsCurrent[s] = 0;
+    for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+        this->policy[s * Maze::ACTION_NUMBER + actionIndex] = statePolicy[actionIndex];
+    }
+}
+
+/**
+ * Overwrites the policy of a single state with an epsilon-greedy one.
+ *
+ * The greedy action receives the bulk of the probability mass; each action,
+ * including the greedy one, receives an equal share of epsilon. An epsilon of
+ * zero yields a discrete, non-probabilistic state policy.
+ *
+ * @param s The index of the state to set the policy of.
+ * @param greedyAction The state's greedy action.
+ * @param epsilon The exploration rate.
+ */
+void Player::setStatePolicy(int s, Maze::Actions greedyAction, double epsilon) {
+    int actionIndex;
+    double *statePolicy;
+    this->greedyActions[s] = -1;
+    this->actionTableIsCurrent[s] = 0;
+    statePolicy = &(this->policy[s * Maze::ACTION_NUMBER]);
+    for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+        if (actionIndex == greedyAction) {
+            statePolicy[actionIndex] = (epsilon / (double)Maze::ACTION_NUMBER) + 1.0 - epsilon;
+        } else {
+            statePolicy[actionIndex] = (epsilon / (double)Maze::ACTION_NUMBER);
+        }
+    }
+}
+
+/**
+ * Switches the player to an implicit epsilon-greedy policy.
+ *
+ * States whose greedy action is set through setGreedyAction() no longer store
+ * their action probabilities; they are derived from the greedy action and the
+ * given exploration rate on demand. States without a greedy action keep their
+ * explicitly stored policy.
+ *
+ * @param epsilon The exploration rate of the implicit policy.
+ */
+void Player::useImplicitPolicy(double epsilon) {
+    this->implicitEpsilon = epsilon;
+}
+
+/**
+ * Sets the greedy action of a state under the implicit epsilon-greedy policy.
+ *
+ * @param s The index of the state to set the greedy action of.
+ * @param greedyAction The state's greedy action.
+ */
+void Player::setGreedyAction(int s, Maze::Actions greedyAction) {
+    this->greedyActions[s] = greedyAction;
+}
+
+/**
+ * Marks the alias table row of a state as outdated.
+ *
+ * Players whose action probabilities change outside of setStatePolicy() should
+ * call this, so that chooseAction() rebuilds the row before drawing from it.
+ *
+ * @param s The index of the state whose action probabilities changed.
+ */
+void Player::invalidateActionTable(int s) {
+    this->actionTableIsCurrent[s] = 0;
+}
+
+/**
+ * Obtains the probability the player's policy assigns to an action in a state.
+ *
+ * @param s The index of the state in the state-action pair.
+ * @param a The action in the state-action pair.
+ * @return The action's probability under the policy.
+ */
+double Player::policyProbability(int s, Maze::Actions a) {
+    if (this->greedyActions[s] < 0) {
+        return this->policy[s * Maze::ACTION_NUMBER + a];
+    } else if (this->greedyActions[s] == a) {
+        return (this->implicitEpsilon / (double)Maze::ACTION_NUMBER) + 1.0 - this->implicitEpsilon;
+    } else {
+        return (this->implicitEpsilon / (double)Maze::ACTION_NUMBER);
     }
 }
 
@@ -86,6 +193,26 @@ Player::Player(Maze* m, double gamma, bool initialiseStochastic) {
     this->currentEpoch = this->timeoutEpoch = 0;
 }
 
+/**
+ * Constructs a player that follows the given policy, rather than a random one.
+ *
+ * Neither state values nor a random policy are initialised, and the alias
+ * table is only sized once the player first draws an action.
+ *
+ * @param m The maze the player needs to solve.
+ * @param policy The policy to follow, laid out as [state][action].
+ * @param gamma The discount factor for earlier-obtained rewards.
+ */
+Player::Player(Maze* m, std::vector<double> policy, double gamma) {
+    this->maze = m;
+    this->discountFactor = gamma;
+    this->policy = std::move(policy);
+    this->greedyActions.assign(this->maze->getStateNumber(), -1);
+    this->implicitEpsilon = 0.0;
+    this->actionTableIsCurrent.assign(this->maze->getStateNumber(), 0);
+    this->currentEpoch = this->timeoutEpoch = 0;
+}
+
 /**
  * Destructs a player.
  */
@@ -95,31 +222,62 @@ Player::~Player() = default;
  * Initialises the state valuations to a pre-specified constant.
  */
 void Player::initialiseStateValues() {
-    int i;
-    State *state;
-    std::vector<State>* states;
-    states = this->maze->getStates();
-    for (i = 0; i < (int)states->size(); i++) {
-        state = &(states->at(i));
-        if (state->getType() == State::Types::goal ||
-            state->getType() == State::Types::pit) {
+    int s;
+    this->stateValues.resize(this->maze->getStateNumber());
+    for (s = 0; s < this->maze->getStateNumber(); s++) {
+        if (this->maze->stateIsTerminal(s)) {
             /* Terminal states' valuations should be their rewards. */
-            this->stateValues[state] = Maze::getReward(state);
+            this->stateValues[s] = this->maze->getReward(s);
         } else {
-            this->stateValues[state] = INITIAL_STATE_VALUE;
+            this->stateValues[s] = INITIAL_STATE_VALUE;
         }
     }
 }
 
+/**
+ * Obtains the most probable action of the player's policy in a state.
+ *
+ * For discrete, non-probabilistic policies, this is the action the player
+ * always intends to take. Ties are broken in favour of the first action.
+ *
+ * @param s The index of the state.
+ * @return The state's most probable action.
+ */
+Maze::Actions Player::policyAction(int s) {
+    int actionIndex, bestIndex;
+    if (this->greedyActions[s] >= 0) {
+        return Maze::actionFromIndex(this->greedyActions[s]);
+    }
+    bestIndex = 0;
+    for (actionIndex = 1; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+        if (this->policy[s * Maze::ACTION_NUMBER + actionIndex] > this->policy[s * Maze::ACTION_NUMBER + bestIndex]) {
+            bestIndex = actionIndex;
+        }
+    }
+    return Maze::actionFromIndex(bestIndex);
+}
+
+/**
+ * Obtains the state whose policy is reported for a position of the maze.
+ *
+ * Players that plan over the maze's positions report each position's own.
+ *
+ * @param position The index of the position within the maze.
+ * @return The index of the representing state.
+ */
+int Player::representativeState(int position) {
+    return position;
+}
+
 /**
  * Obtains the probability of choosing the given action in the specified state.
  *
- * @param s The state in the state-action pair.
+ * @param s The index of the state in the state-action pair.
  * @param a The action in the state-action pair.
  * @return The probability of having the action as intention in the state.
  */
-double Player::actionProbability(State *s, Maze::Actions a) {
-    return this->policy[s][a];
+double Player::actionProbability(int s, Maze::Actions a) {
+    return this->policyProbability(s, a);
 }
 
 /**
@@ -144,21 +302,35 @@ std::vector<double> Player::actionAsActionProbabilityDistribution(Maze::Actions
  * The function looks at the probability of the action according to the policy and returns a randomly chosen
  * action (in accordance with its probability).
  * 
- * @param s the state the action has to be chosen for
+ * States following the implicit epsilon-greedy policy instead draw a single
+ * Bernoulli sample to decide between exploring and taking the greedy action.
+ * Other states draw from their row of the alias table, which is rebuilt from
+ * the action probabilities only when these changed since the last draw. The
+ * table itself is sized on first use, if it was not yet.
+ *
+ * @param s the index of the state the action has to be chosen for
  * @return an action
  */
-Maze::Actions Player::chooseAction(State *s) {
-    int i;
-    double bar, current;
-    bar = RandomServices::continuousUniformSample(1.0);
-    current = this->actionProbability(s, Maze::actionFromIndex(0));
-    for (i = 0; i < Maze::ACTION_NUMBER; i++) {
-        if (bar <= current) {
-            return Maze::actionFromIndex(i);
+Maze::Actions Player::chooseAction(int s) {
+    int actionIndex;
+    double probabilities[Maze::ACTION_NUMBER];
+    if (this->greedyActions[s] >= 0) {
+        if (this->implicitEpsilon > 0.0 && RandomServices::bernoulliSample(this->implicitEpsilon)) {
+            return Maze::actionFromIndex(RandomServices::discreteUniformSample(Maze::ACTION_NUMBER - 1));
         }
-        current += this->actionProbability(s, Maze::actionFromIndex(i + 1));
+        return Maze::actionFromIndex(this->greedyActions[s]);
     }
-    return Maze::actionFromIndex(Maze::ACTION_NUMBER - 1);
+    if (!this->actionTableIsCurrent[s]) {
+        if (this->actionTable.getRowNumber() == 0) {
+            this->actionTable.assign((int)this->actionTableIsCurrent.size(), Maze::ACTION_NUMBER);
+        }
+        for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+            probabilities[actionIndex] = this->actionProbability(s, Maze::actionFromIndex(actionIndex));
+        }
+        this->actionTable.setDistribution(s, probabilities);
+        this->actionTableIsCurrent[s] = 1;
+    }
+    return Maze::actionFromIndex(this->actionTable.sample(s));
 }
 
 /**
@@ -173,20 +345,22 @@ std::vector<double> Player::getEpochTimings() {
 /**
  * Obtains the complete policy of the player.
  *
+ * The policy is laid out densely as [cell][action], with cells counted row by
+ * row over the maze's full width. Cells without a state, i.e. walls, have all
+ * their actions at probability zero.
+ *
  * @return The player's policy.
  */
-std::map<std::tuple<int, int, Maze::Actions>, double> Player::getPolicy() {
-    int stateIndex, actionIndex;
-    State *s;
-    Maze::Actions a;
-    std::tuple<int, int, Maze::Actions> stateActionPair;
-    std::map<std::tuple<int, int, Maze::Actions>, double> outputPolicy;
-    for (stateIndex = 0; stateIndex < (int)this->stateValues.size(); stateIndex++) {
-        s = this->maze->getState(stateIndex);
+std::vector<double> Player::getPolicy() {
+    int s, actionIndex;
+    size_t cellOffset;
+    std::vector<double> outputPolicy;
+    outputPolicy.assign((size_t)this->maze->getCellNumber() * Maze::ACTION_NUMBER, 0.0);
+    for (s = 0; s < this->maze->getStateNumber(); s++) {
+        cellOffset = (size_t)this->maze->getCellOfState(s) * Maze::ACTION_NUMBER;
         for (actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-            a = Maze::actionFromIndex(actionIndex);
-            stateActionPair = std::make_tuple(s->getX(), s->getY(), a);
-            outputPolicy[stateActionPair] = this->policy[s][a];
+            outputPolicy[cellOffset + actionIndex] = this->policyProbability(this->representativeState(s),
+                    Maze::actionFromIndex(actionIndex));
         }
     }
     return outputPolicy;
@@ -20,21 +20,19 @@ PolicyIterationPlayer::~PolicyIterationPlayer() = default;
 /**
  * Obtains the valuation of the given state, if its dominant action is supplied.
  *
- * @param s The state to evaluate.
+ * @param s The index of the state to evaluate.
  * @param a The dominant action to undertake in this state.
  * @return The state's value.
  */
-double PolicyIterationPlayer::stateValue(State *s, Maze::Actions a) {
+double PolicyIterationPlayer::stateValue(int s, Maze::Actions a) {
     int i;
     double newValue;
-    State *nextState;
-    Maze::Actions actualAction;
+    const Maze::Transition *outcomes;
     newValue = 0.0;
+    outcomes = this->space->getTransitions(s, a);
     for (i = 0; i < Maze::ACTION_NUMBER; i++) {
         /* Given our choice of action, consider all possible results and their valuations. */
-        actualAction = Maze::actionFromIndex((a + i) % Maze::ACTION_NUMBER);
-        nextState = this->maze->getNextStateDeterministic(s, actualAction);
-        newValue += this->maze->getActionProbability(i) * this->oldStateValues[nextState];
+        newValue += outcomes[i].probability * this->backupValue(outcomes[i].nextIndex);
     }
     return newValue;
 }
@@ -42,21 +40,21 @@ double PolicyIterationPlayer::stateValue(State *s, Maze::Actions a) {
 /**
  * Obtains an updated version of the state's value, given current information.
  *
- * @param s The state to evaluate.
+ * @param s The index of the state to evaluate.
  * @param a The dominant action to undertake in this state.
  * @return The state's value.
  */
-double PolicyIterationPlayer::updatedStateValue(State *s, Maze::Actions a) {
-    return Maze::getReward(s) + this->discountFactor * this->stateValue(s, a);
+double PolicyIterationPlayer::updatedStateValue(int s, Maze::Actions a) {
+    return this->space->getReward(s) + this->discountFactor * this->stateValue(s, a);
 }
 
 /**
  * Obtains the greedy action for the supplied state.
  *
- * @param s The state for which to get the greedy action.
+ * @param s The index of the state for which to get the greedy action.
  * @return The state's greedy action.
  */
-Maze::Actions PolicyIterationPlayer::greedyActionForState(State *s) {
+Maze::Actions PolicyIterationPlayer::greedyActionForState(int s) {
     double bestValue, currentValue;
     int bestIndex, i;
     bestIndex = 0;
@@ -8,9 +8,10 @@
  * @param T The maximum iteration before forcing a stop.
  * @param alpha The learning rate.
  * @param epsilon The exploration rate.
+ * @param lanes The number of episodes to play in lockstep.
  */
-QLearningPlayer::QLearningPlayer(Maze *m, double gamma, int T, double alpha, double epsilon) :
-        TimeDifferencePlayer(m, gamma, T, alpha, epsilon) {
+QLearningPlayer::QLearningPlayer(Maze *m, double gamma, int T, double alpha, double epsilon, int lanes) :
+        TimeDifferencePlayer(m, gamma, T, alpha, epsilon, lanes) {
     this->updatePolicyUsingStateActionValues();
 }
 
@@ -24,6 +25,10 @@ QLearningPlayer::~QLearningPlayer() = default;
  * whilst learning from doing so.
  */
 void QLearningPlayer::solveMaze() {
+    if (this->batch != nullptr) {
+        this->solveMazeInBatches();
+        return;
+    }
     do {
         auto startTime = std::chrono::high_resolution_clock::now();
         this->performIteration();
@@ -37,7 +42,7 @@ void QLearningPlayer::solveMaze() {
  * player tries to navigate the maze. Every iteration adds 1 to the current epoch.
  */
 void QLearningPlayer::performIteration() {
-    std::tuple<State*, Maze::Actions> startStateActionPair;
+    std::tuple<int, Maze::Actions> startStateActionPair;
     startStateActionPair = this->initialStateActionPair();
     this->generateEpisode(startStateActionPair);
     this->addRewardsToTotalRewardPerEpisode();
@@ -51,33 +56,40 @@ void QLearningPlayer::performIteration() {
  * function continues until the player reached the end of the maze or has reached the maximum
  * amount of steps for an episode.
  */
-void QLearningPlayer::generateEpisode(std::tuple<State*, Maze::Actions> startStateActionPair) {
-    std::tuple<State*, Maze::Actions> stateActionPair, nextStateActionPair;
+void QLearningPlayer::generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) {
+    std::tuple<int, Maze::Actions> stateActionPair, nextStateActionPair;
     int currentIteration, maximumIteration;
-    maximumIteration = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->stateValues.size());
+    maximumIteration = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->maze->getCellNumber());
     currentIteration = -1;
     stateActionPair = startStateActionPair;
     do {
         currentIteration++;
         nextStateActionPair = this->nextStateActionPair(stateActionPair);
-        this->updateStateActionValue(stateActionPair, nextStateActionPair);
-        this->updatePolicyUsingStateActionValues(std::get<0>(stateActionPair));
+        this->learnFromStep(std::get<0>(stateActionPair), std::get<1>(stateActionPair), this->rewards.back(),
+                std::get<0>(nextStateActionPair), std::get<1>(nextStateActionPair));
         stateActionPair = nextStateActionPair;
-    } while (currentIteration < maximumIteration && !Maze::stateIsTerminal(std::get<0>(stateActionPair)));
+    } while (currentIteration < maximumIteration && !this->maze->stateIsTerminal(std::get<0>(stateActionPair)));
     this->maze->resetMaze();
 }
 
 /**
- * This function updates the state values according to the Q-learning update function.
+ * This function updates the state values according to the Q-learning update function, and makes
+ * the policy of the state acted in greedy with respect to them.
+ *
+ * @param s The index of the state acted in.
+ * @param a The action taken.
+ * @param reward The reward obtained for the action.
+ * @param next The index of the resulting state.
+ * @param nextAction The action chosen in the resulting state. Unused, as Q-learning is off-policy.
  */
-void QLearningPlayer::updateStateActionValue(std::tuple<State*, Maze::Actions> stateActionPair, std::tuple<State*,
-        Maze::Actions> nextStateActionPair) {
-    std::tuple<State*, Maze::Actions> greedyNextStateActionPair;
-    greedyNextStateActionPair = std::make_tuple(std::get<0>(nextStateActionPair),
-            this->greedyAction(std::get<0>(nextStateActionPair)));
-    this->stateActionValues[stateActionPair] = this->stateActionValues[stateActionPair] +
-            this->alpha * (this->rewards.back() + this->discountFactor * this->stateActionValues[greedyNextStateActionPair]
-            - this->stateActionValues[stateActionPair]);
+void QLearningPlayer::learnFromStep(int s, Maze::Actions a, double reward, int next, Maze::Actions nextAction) {
+    int current;
+    double greedyNextValue;
+    current = LearningPlayer::stateActionIndex(std::make_tuple(s, a));
+    greedyNextValue = this->stateActionValues.maximumValue(next);
+    this->stateActionValues[current] = this->stateActionValues[current] +
+            this->alpha * (reward + this->discountFactor * greedyNextValue - this->stateActionValues[current]);
+    this->updatePolicyUsingStateActionValues(s);
 }
 
 /**
@@ -85,8 +97,8 @@ void QLearningPlayer::updateStateActionValue(std::tuple<State*, Maze::Actions> s
  * 
  * @return startStateActionPair The state action pair where the player should begin
  */
-std::tuple<State*, Maze::Actions> QLearningPlayer::initialStateActionPair() {
-    State *s;
+std::tuple<int, Maze::Actions> QLearningPlayer::initialStateActionPair() {
+    int s;
     Maze::Actions a;
     s = this->maze->getStartingState();
     a = this->chooseAction(s);
@@ -100,9 +112,9 @@ std::tuple<State*, Maze::Actions> QLearningPlayer::initialStateActionPair() {
  * @param currentPair The state which the player is in first combined with the action it's going to do
  * @return The state action pair of the new state the player is in
  */
-std::tuple<State*, Maze::Actions> QLearningPlayer::nextStateActionPair(
-        std::tuple<State *, Maze::Actions> currentPair) {
-    std::tuple<State*, double> result;
+std::tuple<int, Maze::Actions> QLearningPlayer::nextStateActionPair(
+        std::tuple<int, Maze::Actions> currentPair) {
+    std::tuple<int, double> result;
     result = this->maze->getStateTransitionResult(std::get<0>(currentPair), std::get<1>(currentPair));
     this->rewards.push_back(std::get<1>(result));
     return std::make_tuple(std::get<0>(result), this->chooseAction(std::get<0>(result)));
@@ -112,47 +124,15 @@ std::tuple<State*, Maze::Actions> QLearningPlayer::nextStateActionPair(
  * Update the policy values according to an epsilon-greedy representation of the state values.
  */
 void QLearningPlayer::updatePolicyUsingStateActionValues() {
-    State *state;
-    Maze::Actions greedyAction, currentAction;
-    std::vector<State>* states;
-    std::vector<double> newPolicy;
-    double newActionProbability;
-    states = this->maze->getStates();
-    for (int i = 0; i < (int)states->size(); i++) {
-        state = &(states->at(i));
-        greedyAction = this->greedyAction(state);
-        for (int actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-            currentAction = Maze::actionFromIndex(actionIndex);
-            if (currentAction == greedyAction) {
-                newActionProbability = (this->epsilon / (double)Maze::ACTION_NUMBER) + 1.0 - this->epsilon;
-            } else {
-                newActionProbability = (this->epsilon / (double)Maze::ACTION_NUMBER);
-            }
-            newPolicy.push_back(newActionProbability);
-        }
-        this->policy[state] = newPolicy;
-    }
+    this->stateActionValues.greedyActions(&this->greedyActions);
 }
 
 /**
  * This function updates the policy of the provided state using an epsilon-greedy approach.
  * It is epsilon-greedy for the state action values.
  *
- * @param state The state for which we update the policy
+ * @param state The index of the state for which we update the policy
  */
-void QLearningPlayer::updatePolicyUsingStateActionValues(State *state) {
-    Maze::Actions greedyAction, currentAction;
-    std::vector<double> newPolicy;
-    double newActionProbability;
-    greedyAction = this->greedyAction(state);
-    for (int actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-        currentAction = Maze::actionFromIndex(actionIndex);
-        if (currentAction == greedyAction) {
-            newActionProbability = (this->epsilon / (double)Maze::ACTION_NUMBER) + 1.0 - this->epsilon;
-        } else {
-            newActionProbability = (this->epsilon / (double)Maze::ACTION_NUMBER);
-        }
-        newPolicy.push_back(newActionProbability);
-    }
-    this->policy[state] = newPolicy;
+void QLearningPlayer::updatePolicyUsingStateActionValues(int state) {
+    this->setGreedyAction(state, this->greedyAction(state));
 }
@@ -0,0 +1,197 @@
+#include <cstdlib>
+#include <algorithm>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+#include "QTable.hpp"
+
+static_assert(Maze::ACTION_NUMBER == 4, "The Q-table's kernels assume four actions per state.");
+
+/**
+ * Allocates an aligned, uninitialised buffer for the given number of states.
+ *
+ * Each state's row of action values spans exactly 32 bytes, so with the
+ * buffer aligned to 32 bytes every row is, too.
+ *
+ * @param states The number of states to allocate for.
+ */
+void QTable::allocate(int states) {
+    void *memory;
+    this->stateNumber = states;
+    this->values = nullptr;
+    if (states > 0 && posix_memalign(&memory, ALIGNMENT, states * Maze::ACTION_NUMBER * sizeof(double)) == 0) {
+        this->values = (double*)memory;
+    } else if (states > 0) {
+        printf("[QTable] Error: Could not allocate %d states. Aborting.\n", states);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * Frees the table's buffer.
+ */
+void QTable::release() {
+    free(this->values);
+    this->values = nullptr;
+    this->stateNumber = 0;
+}
+
+/**
+ * Constructs a Q-table.
+ *
+ * @param states The number of states to hold action values for.
+ * @param initialValue The value to initialise every state-action pair with.
+ */
+QTable::QTable(int states, double initialValue) {
+    this->allocate(states);
+    std::fill(this->values, this->values + states * Maze::ACTION_NUMBER, initialValue);
+}
+
+/**
+ * Constructs a Q-table as a copy of another.
+ *
+ * @param other The table to copy.
+ */
+QTable::QTable(const QTable &other) {
+    this->allocate(other.stateNumber);
+    std::copy(other.values, other.values + other.stateNumber * Maze::ACTION_NUMBER, this->values);
+}
+
+/**
+ * Overwrites this Q-table with a copy of another.
+ *
+ * @param other The table to copy.
+ * @return This table.
+ */
+QTable& QTable::operator=(const QTable &other) {
+    if (this != &other) {
+        this->release();
+        this->allocate(other.stateNumber);
+        std::copy(other.values, other.values + other.stateNumber * Maze::ACTION_NUMBER, this->values);
+    }
+    return *this;
+}
+
+/**
+ * Destructs the Q-table.
+ */
+QTable::~QTable() {
+    this->release();
+}
+
+/**
+ * Resizes the table, and sets every state-action pair to the given value.
+ *
+ * @param states The number of states to hold action values for.
+ * @param value The value to set.
+ */
+void QTable::assign(int states, double value) {
+    if (states != this->stateNumber) {
+        this->release();
+        this->allocate(states);
+    }
+    std::fill(this->values, this->values + states * Maze::ACTION_NUMBER, value);
+}
+
+/**
+ * Obtains a reference to the value of a state-action pair.
+ *
+ * @param stateActionIndex The flat index of the pair, being the state's index
+ *      times the number of actions, plus the action.
+ * @return The pair's value.
+ */
+double& QTable::operator[](int stateActionIndex) {
+    return this->values[stateActionIndex];
+}
+
+/**
+ * Obtains the row of action values of a state.
+ *
+ * @param s The index of the state.
+ * @return The state's action values, one per action.
+ */
+const double* QTable::getStateValues(int s) const {
+    return this->values + s * Maze::ACTION_NUMBER;
+}
+
+/**
+ * Obtains the number of states the table holds action values for.
+ *
+ * @return The number of states.
+ */
+int QTable::getStateNumber() const {
+    return this->stateNumber;
+}
+
+/**
+ * Obtains the largest action value of a state.
+ *
+ * @param s The index of the state.
+ * @return The state's maximum action value.
+ */
+double QTable::maximumValue(int s) const {
+    const double *row = this->getStateValues(s);
+#if defined(__AVX__)
+    __m256d v, m;
+    v = _mm256_load_pd(row);
+    m = _mm256_max_pd(v, _mm256_permute2f128_pd(v, v, 1));
+    m = _mm256_max_pd(m, _mm256_permute_pd(m, 0x5));
+    return _mm256_cvtsd_f64(m);
+#elif defined(__SSE2__)
+    __m128d m;
+    m = _mm_max_pd(_mm_load_pd(row), _mm_load_pd(row + 2));
+    m = _mm_max_pd(m, _mm_shuffle_pd(m, m, 1));
+    return _mm_cvtsd_f64(m);
+#else
+    return std::max(std::max(row[0], row[1]), std::max(row[2], row[3]));
+#endif
+}
+
+/**
+ * Obtains the action with the largest value in a state.
+ *
+ * Ties are broken in favour of the action listed first, so that the outcome
+ * equals that of a sequential scan using a strict comparison.
+ *
+ * @param s The index of the state.
+ * @return The state's greedy action.
+ */
+Maze::Actions QTable::greedyAction(int s) const {
+    const double *row = this->getStateValues(s);
+#if defined(__AVX__) || defined(__SSE2__)
+    int mask;
+    double best = this->maximumValue(s);
+#if defined(__AVX__)
+    mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_load_pd(row), _mm256_set1_pd(best), _CMP_EQ_OQ));
+#else
+    __m128d m = _mm_set1_pd(best);
+    mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_load_pd(row), m)) |
+           (_mm_movemask_pd(_mm_cmpeq_pd(_mm_load_pd(row + 2), m)) << 2);
+#endif
+    /* Without a match (i.e. with NaN values), fall back on the first action. */
+    return Maze::actionFromIndex(mask == 0 ? 0 : __builtin_ctz(mask));
+#else
+    int actionIndex, bestIndex;
+    bestIndex = 0;
+    for (actionIndex = 1; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
+        if (row[actionIndex] > row[bestIndex]) {
+            bestIndex = actionIndex;
+        }
+    }
+    return Maze::actionFromIndex(bestIndex);
+#endif
+}
+
+/**
+ * Obtains the greedy actions of all states at once.
+ *
+ * @param out The vector to store the greedy actions in, indexed by state. It
+ *      is resized to the number of states.
+ */
+void QTable::greedyActions(std::vector<int> *out) const {
+    int s;
+    out->resize(this->stateNumber);
+    for (s = 0; s < this->stateNumber; s++) {
+        (*out)[s] = this->greedyAction(s);
+    }
+}
\ No newline at end of file
@@ -1,34 +1,204 @@
-#include <ctime>
-#include <cstdlib>
 #include <cmath>
+#include <algorithm>
 #include "RandomServices.hpp"
 
-static double firstNormal;
-static double secondNormal;
-static bool shouldGenerate;
+/* The Philox4x32 multipliers and Weyl key increments. */
+static const uint32_t PHILOX_MULTIPLIERS[2] = {0xD2511F53u, 0xCD9E8D57u};
+static const uint32_t PHILOX_INCREMENTS[2] = {0x9E3779B9u, 0xBB67AE85u};
+
+uint64_t RandomServices::masterSeed = 0;
+
+/* The stream of the main thread, and of threads that never selected one. */
+static thread_local RandomServices::Stream currentStream = {{RandomServices::MAIN_RUN, 0, 0}, 0, {0, 0, 0, 0}, 4,
+        0.0, false};
+
+/**
+ * Sets the master seed, from which all streams' keys are derived.
+ *
+ * @param masterSeed The master seed.
+ */
+void RandomServices::seed(uint64_t masterSeed) {
+    RandomServices::masterSeed = masterSeed;
+}
+
+/**
+ * Generates the next blocks of four random words of the given stream.
+ *
+ * This is the Philox4x32-10 counter-based generator of Salmon et al. (2011).
+ * Its 128-bit counter consists of the stream's block number and identifier,
+ * and its 64-bit key is the master seed. Each block is thus a pure function
+ * of where it sits, which makes streams independent of the order (and the
+ * threads) in which they are drawn from.
+ *   The blocks' counters are kept side by side, one array per counter word,
+ * so that all blocks go through each round together; compilers vectorise
+ * this.
+ *
+ * @param stream The stream to generate blocks for.
+ * @param blockNumber The number of blocks. At most BULK_BLOCKS.
+ * @param words Output parameter. The blocks' words, one block after another.
+ */
+void RandomServices::generateBlocks(Stream *stream, int blockNumber, uint32_t *words) {
+    uint32_t counters[4][BULK_BLOCKS], key[2];
+    uint64_t firstProduct, secondProduct;
+    int round, blockIndex;
+    for (blockIndex = 0; blockIndex < blockNumber; blockIndex++) {
+        counters[0][blockIndex] = stream->block + (uint32_t)blockIndex;
+        counters[1][blockIndex] = stream->identifier[0];
+        counters[2][blockIndex] = stream->identifier[1];
+        counters[3][blockIndex] = stream->identifier[2];
+    }
+    key[0] = (uint32_t)masterSeed;
+    key[1] = (uint32_t)(masterSeed >> 32);
+    for (round = 0; round < PHILOX_ROUNDS; round++) {
+        for (blockIndex = 0; blockIndex < blockNumber; blockIndex++) {
+            firstProduct = (uint64_t)PHILOX_MULTIPLIERS[0] * counters[0][blockIndex];
+            secondProduct = (uint64_t)PHILOX_MULTIPLIERS[1] * counters[2][blockIndex];
+            counters[0][blockIndex] = (uint32_t)(secondProduct >> 32) ^ counters[1][blockIndex] ^ key[0];
+            counters[1][blockIndex] = (uint32_t)secondProduct;
+            counters[2][blockIndex] = (uint32_t)(firstProduct >> 32) ^ counters[3][blockIndex] ^ key[1];
+            counters[3][blockIndex] = (uint32_t)firstProduct;
+        }
+        key[0] += PHILOX_INCREMENTS[0];
+        key[1] += PHILOX_INCREMENTS[1];
+    }
+    for (blockIndex = 0; blockIndex < blockNumber; blockIndex++) {
+        words[blockIndex * 4] = counters[0][blockIndex];
+        words[blockIndex * 4 + 1] = counters[1][blockIndex];
+        words[blockIndex * 4 + 2] = counters[2][blockIndex];
+        words[blockIndex * 4 + 3] = counters[3][blockIndex];
+    }
+    stream->block += (uint32_t)blockNumber;
+}
+
+/**
+ * Generates the next block of four random words of the given stream, to be
+ * drawn from one by one.
+ *
+ * @param stream The stream to generate a block for.
+ */
+void RandomServices::generateBlock(Stream *stream) {
+    generateBlocks(stream, 1, stream->output);
+    stream->outputIndex = 0;
+}
+
+/**
+ * Combines two random words into a random value between zero (inclusive) and
+ * one (exclusive).
+ *
+ * @param first The first word drawn.
+ * @param second The second word drawn.
+ * @return The random value.
+ */
+double RandomServices::valueFromWords(uint32_t first, uint32_t second) {
+    uint64_t bits;
+    bits = ((uint64_t)first << 21) ^ (uint64_t)(second >> 11);
+    return (double)bits * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Obtains the next random word of the calling thread's stream.
+ *
+ * @return A uniformly distributed 32-bit word.
+ */
+uint32_t RandomServices::randomWord() {
+    if (currentStream.outputIndex == 4) {
+        generateBlock(&currentStream);
+    }
+    return currentStream.output[currentStream.outputIndex++];
+}
 
 /**
- * Provides a sequence-starter for the RNG's pseudorandom number sequence.
+ * Obtains the master seed the RNG was initialised with.
+ *
+ * @return The master seed.
  */
-void RandomServices::seed() {
-    srandom(time(nullptr));
+uint64_t RandomServices::getMasterSeed() {
+    return masterSeed;
 }
 
 /**
- * Initialises the component of the RNG responsible for Gaussian values.
+ * Makes the calling thread draw from the start of the identified stream.
+ *
+ * Work that should give the same numbers no matter which thread carries it out
+ * selects a stream by what it is, rather than by where it runs.
+ *
+ * @param run The run the stream belongs to.
+ * @param player The index of the player within the run.
+ * @param worker The index of the player's worker. Zero for the player itself.
  */
-void RandomServices::initialiseNormalNumberGenerator() {
-    shouldGenerate = false;
-    firstNormal = secondNormal = 0.0;
+void RandomServices::selectStream(uint32_t run, uint32_t player, uint32_t worker) {
+    currentStream.identifier[0] = worker;
+    currentStream.identifier[1] = player;
+    currentStream.identifier[2] = run;
+    currentStream.block = 0;
+    currentStream.outputIndex = 4;
+    currentStream.hasSpareNormal = false;
 }
 
 /**
- * Obtains a random integer within the RNG's generation boundaries.
+ * Obtains the calling thread's stream, including its position.
  *
- * @return A random integer.
+ * @return The stream.
+ */
+RandomServices::Stream RandomServices::getStream() {
+    return currentStream;
+}
+
+/**
+ * Makes the calling thread continue drawing from the given stream.
+ *
+ * @param stream The stream, as obtained earlier from getStream.
+ */
+void RandomServices::setStream(const Stream& stream) {
+    currentStream = stream;
+}
+
+/**
+ * Obtains a random value between zero (inclusive) and one (exclusive).
+ *
+ * Two words of the stream make up the 53 bits of the value's mantissa.
+ *
+ * @return A random value.
  */
 double RandomServices::randomValue() {
-    return (double)random() * (1.0 / RAND_MAX);
+    uint32_t first;
+    first = randomWord();
+    return valueFromWords(first, randomWord());
+}
+
+/**
+ * Obtains a number of random values between zero (inclusive) and one
+ * (exclusive) at once.
+ *
+ * The values are exactly those that as many calls to randomValue() would
+ * give, but whole blocks of the stream are generated together.
+ *
+ * @param values Output parameter. The random values.
+ * @param number The number of values to obtain.
+ */
+void RandomServices::randomValues(double *values, int number) {
+    int valueIndex, wordIndex, wordNumber, blockNumber;
+    uint32_t words[4 * BULK_BLOCKS + 4];
+    valueIndex = 0;
+    while (valueIndex < number && currentStream.outputIndex < 3) {
+        /* At least two words are left in the current block. */
+        values[valueIndex++] = randomValue();
+    }
+    while (valueIndex < number) {
+        wordNumber = 0;
+        while (currentStream.outputIndex < 4) {
+            words[wordNumber++] = currentStream.output[currentStream.outputIndex++];
+        }
+        blockNumber = std::min((int)BULK_BLOCKS, (2 * (number - valueIndex) - wordNumber + 3) / 4);
+        generateBlocks(&currentStream, blockNumber, words + wordNumber);
+        wordNumber += 4 * blockNumber;
+        for (wordIndex = 0; wordIndex + 1 < wordNumber && valueIndex < number; wordIndex += 2) {
+            values[valueIndex++] = valueFromWords(words[wordIndex], words[wordIndex + 1]);
+        }
+        /* Unused words, if any, are the last block's final ones; keep them for later draws. */
+        std::copy(words + wordNumber - 4, words + wordNumber, currentStream.output);
+        currentStream.outputIndex = 4 - (wordNumber - wordIndex);
+    }
 }
 
 /**
@@ -38,7 +208,7 @@ double RandomServices::randomValue() {
  *   This method uses the Box-Muller transform, in which two 'proto-normal'
  * values are obtained per generation step. These proto-normal values are
  * then - given the arguments - transformed to proper Gaussian samples (thus,
- * the name).
+ * the name). The second value is kept in the calling thread's stream.
  *   Code is an adaptation of that supplied on Wikipedia. See
  * https://en.wikipedia.org/wiki/Box–Muller_transform.
  *
@@ -48,20 +218,20 @@ double RandomServices::randomValue() {
  */
 double RandomServices::normalSample(double mean, double standardDeviation) {
     double firstFraction, secondFraction;
-    shouldGenerate = !shouldGenerate;
-    if (!shouldGenerate) {
+    if (currentStream.hasSpareNormal) {
         /* We have a second random normal value stored. Use that one. */
-        return secondNormal * standardDeviation + mean;
+        currentStream.hasSpareNormal = false;
+        return currentStream.spareNormal * standardDeviation + mean;
     }
     do {
         /* Generate the random fractions; ensure they do not underflow. */
         firstFraction  = randomValue();
         secondFraction = randomValue();
     } while (firstFraction <= epsilon);
-    /* Generate two random normal values; use only the first one. */
-    firstNormal  = sqrt(-2.0 * log(firstFraction)) * cos(twoPi * secondFraction);
-    secondNormal = sqrt(-2.0 * log(firstFraction)) * sin(twoPi * secondFraction);
-    return firstNormal;
+    /* Generate two random normal values; keep the second one for later. */
+    currentStream.spareNormal = sqrt(-2.0 * log(firstFraction)) * sin(twoPi * secondFraction);
+    currentStream.hasSpareNormal = true;
+    return sqrt(-2.0 * log(firstFraction)) * cos(twoPi * secondFraction) * standardDeviation + mean;
 }
 
 /**
@@ -79,24 +249,25 @@ bool RandomServices::bernoulliSample(double p) {
  *
  * Sampling starts from zero (inclusive), and ends at the specified ceiling.
  * Said ceiling is inclusive, too.
+ *   This is Lemire's (2019) multiply-and-shift method: the product of a random
+ * word and the range has its sample in the high word. Only when the low word
+ * falls in the (small) biased zone is a division needed, and a word redrawn.
  *
  * @param ceiling The ceiling number of the distribution. Inclusive.
  * @return The sample.
  */
 int RandomServices::discreteUniformSample(int ceiling) {
-    double random;
-    double range[2] = {0.0, 1.0};
-    int sample;
-    bool isWithinRange;
-    random = (ceiling + 1) * randomValue();
-    sample = -1;
-    do {
-        /* Find the bin which 'contains' our random value. */
-        sample++;
-        isWithinRange = (range[0] <= random && range[1] > random);
-        range[0] += 1.0; range[1] += 1.0;
-    } while (!isWithinRange && range[0] <= (double)ceiling);
-    return sample;
+    uint32_t range, threshold;
+    uint64_t product;
+    range = (uint32_t)ceiling + 1;
+    product = (uint64_t)randomWord() * range;
+    if ((uint32_t)product < range) {
+        threshold = (0u - range) % range;
+        while ((uint32_t)product < threshold) {
+            product = (uint64_t)randomWord() * range;
+        }
+    }
+    return (int)(product >> 32);
 }
 
 /**
@@ -144,9 +315,11 @@ double RandomServices::continuousUniformSample(double min, double max) {
  * Initialises the RNG.
  *
  * Calling this method at the top of the main program is essential for this
- * class to work effectively.
+ * class to work effectively. Equal master seeds give equal experiments.
+ *
+ * @param masterSeed The master seed to derive all streams from.
  */
-void RandomServices::initialiseRandomServices() {
-    seed();
-    initialiseNormalNumberGenerator();
-}
+void RandomServices::initialiseRandomServices(uint64_t masterSeed) {
+    seed(masterSeed);
+    selectStream(MAIN_RUN, 0);
+}
\ No newline at end of file
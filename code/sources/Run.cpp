@@ -1,33 +1,52 @@
 #include <utility>
+#include "RandomServices.hpp"
 #include "Run.hpp"
 
 /**
  * Builds, for each player participating in the run, an identical maze.
  *
- * It is recommended that pre-specified mazes are fed into this method,
- * especially when a significant amount of runs are involved.
+ * All players' mazes share the layout, and only keep their own episode's
+ * dynamics.
  *
- * @param mazeIdentifier The maze identifier to build with.
+ * @param layout The layout to build with.
  */
-void Run::buildMazes(const std::string& mazeIdentifier) {
+void Run::buildMazes(const std::shared_ptr<const MazeLayout>& layout) {
     int mazeIndex;
     for (mazeIndex = 0; mazeIndex < (int)this->playerSelection.size(); mazeIndex++) {
-        this->mazes.push_back(new Maze(mazeIdentifier));
+        this->mazes.push_back(new Maze(layout));
     }
 }
 
 /**
  * Constructs a run.
  *
+ * The maze's layout is read only once, for all players of the run.
+ *
  * @param id The identifier of this run.
  * @param mazeIdentifier The maze's identifier associated with this run.
  * @param playerSelection The selection of player types involved in this run.
+ * @param configuration The configuration to run the players with.
  */
-Run::Run(int id, std::string mazeIdentifier, std::vector<Player::Types> playerSelection) :
-        results(id) {
+Run::Run(int id, const std::string& mazeIdentifier, std::vector<Player::Types> playerSelection,
+        Configuration configuration) : Run(id, std::make_shared<const MazeLayout>(mazeIdentifier),
+        std::move(playerSelection), configuration) {}
+
+/**
+ * Constructs a run on an existing maze layout.
+ *
+ * @param id The identifier of this run.
+ * @param layout The layout of the maze associated with this run. It may be
+ *      shared with other runs.
+ * @param playerSelection The selection of player types involved in this run.
+ * @param configuration The configuration to run the players with.
+ */
+Run::Run(int id, const std::shared_ptr<const MazeLayout>& layout, std::vector<Player::Types> playerSelection,
+        Configuration configuration) : results(id) {
     this->id = id;
+    this->configuration = configuration;
     this->playerSelection = std::move(playerSelection);
-    this->buildMazes(mazeIdentifier);
+    this->buildMazes(layout);
+    this->players.assign(this->playerSelection.size(), nullptr);
 }
 
 /**
@@ -35,6 +54,7 @@ Run::Run(int id, std::string mazeIdentifier, std::vector<Player::Types> playerSe
  */
 Run::~Run() {
     int mazeIndex, mazeSize;
+    this->deallocatePlayers();
     mazeSize = (int)this->mazes.size();
     for (mazeIndex = 0; mazeIndex < mazeSize; mazeIndex++) {
         delete this->mazes[mazeIndex];
@@ -42,74 +62,80 @@ Run::~Run() {
 }
 
 /**
- * Create a player of the provided type and add the player to the vector 'players'.
- * 
+ * Create a player of the provided type and store it in the vector 'players'.
+ *
+ * @param playerIndex the index of the player within the run
  * @param type the type of player that has to be created
- * @return the created player
  */
 void Run::allocatePlayer(int playerIndex, Player::Types type) {
     switch (type) {
         case Player::Types::SynchronousPolicyIteration:
-            this->players.push_back(new SynchronousPolicyIterationPlayer(this->mazes[playerIndex], 0.9,
-                    1e-3));
+            this->players[playerIndex] = new SynchronousPolicyIterationPlayer(this->mazes[playerIndex], 0.9,
+                    1e-3, this->configuration.useExactEvaluation());
             break;
         case Player::Types::AsynchronousPolicyIteration:
-            this->players.push_back(new AsynchronousPolicyIterationPlayer(this->mazes[playerIndex], 0.9,
-                    1e-3, 1e3));
+            this->players[playerIndex] = new AsynchronousPolicyIterationPlayer(this->mazes[playerIndex], 0.9,
+                    1e-3, 1e3);
             break;
         case Player::Types::SynchronousValueIteration:
-            this->players.push_back(new SynchronousValueIterationPlayer(this->mazes[playerIndex], 0.9,
-                    1e-3));
+            this->players[playerIndex] = new SynchronousValueIterationPlayer(this->mazes[playerIndex], 0.9,
+                    1e-3, this->configuration.getSweepThreads());
             break;
         case Player::Types::AsynchronousValueIteration:
-            this->players.push_back(new AsynchronousValueIterationPlayer(this->mazes[playerIndex], 0.9,
-                    1e-3, 1e3));
+            this->players[playerIndex] = new AsynchronousValueIterationPlayer(this->mazes[playerIndex], 0.9,
+                    1e-3, 1e3, this->configuration.usePrioritizedSweeping());
             break;
         case Player::Types::MonteCarloExploringStarts:
-            this->players.push_back(new MonteCarloExploringStartsPlayer(this->mazes[playerIndex],
-                    9e-1, 4e3));
+            this->players[playerIndex] = new MonteCarloExploringStartsPlayer(this->mazes[playerIndex],
+                    9e-1, 4e3);
             break;
         case Player::Types::MonteCarloFirstVisit:
-            this->players.push_back(new MonteCarloFirstVisitPlayer(this->mazes[playerIndex],
-                    9e-1, 4e3, 3e-3));
+            this->players[playerIndex] = new MonteCarloFirstVisitPlayer(this->mazes[playerIndex],
+                    9e-1, 4e3, 3e-3);
             break;
         case Player::Types::MonteCarloEveryVisit:
-            this->players.push_back(new MonteCarloEveryVisitPlayer(this->mazes[playerIndex], 9e-1,
-                    8e3));
+            this->players[playerIndex] = new MonteCarloEveryVisitPlayer(this->mazes[playerIndex], 9e-1,
+                    8e3);
             break;
         case Player::Types::TDSarsa:
-            this->players.push_back(new SarsaPlayer(this->mazes[playerIndex], 9e-1, 8e3, 1e-1,
-                    3e-3));
+            this->players[playerIndex] = new SarsaPlayer(this->mazes[playerIndex], 9e-1, 8e3, 1e-1,
+                    3e-3, this->configuration.getLanes());
             break;
         case Player::Types::TDQLearning:
-            this->players.push_back(new QLearningPlayer(this->mazes[playerIndex], 9e-1, 8e3, 1e-1,
-                                                        3e-3));
+            this->players[playerIndex] = new QLearningPlayer(this->mazes[playerIndex], 9e-1, 8e3, 1e-1,
+                    3e-3, this->configuration.getLanes());
             break;
         default:
-            this->players.push_back(new RandomPlayer(this->mazes[playerIndex]));
+            this->players[playerIndex] = new RandomPlayer(this->mazes[playerIndex]);
             break;
     }
 }
 
 /**
- * Loop through all players selected for this run, create the players using Player and allocate them to
- * the vector 'players'.
+ * Obtains the number of players selected for this run.
+ *
+ * @return The number of players.
  */
-void Run::allocatePlayers() {
-    int selectedPlayerIndex;
-    for (selectedPlayerIndex = 0; selectedPlayerIndex < (int)this->playerSelection.size(); selectedPlayerIndex++) {
-        this->allocatePlayer(selectedPlayerIndex, this->playerSelection[selectedPlayerIndex]);
-    }
+int Run::getPlayerNumber() {
+    return (int)this->playerSelection.size();
 }
 
 /**
- * Make all players selected for this run solve the maze.
+ * Creates a single player of this run, and makes it solve its maze.
+ *
+ * Each player has a maze of its own, so distinct players of the same run may
+ * be conducted concurrently. The player draws from a random stream of its own
+ * as well, which makes its results independent of the thread conducting it.
+ *
+ * @param playerIndex The index of the player within the run.
  */
-void Run::runAlgorithms() {
-    int playerIndex;
-    for (playerIndex = 0; playerIndex < (int)this->players.size(); playerIndex++) {
-        this->players[playerIndex]->solveMaze();
-    }
+void Run::conductPlayer(int playerIndex) {
+    RandomServices::Stream previousStream;
+    previousStream = RandomServices::getStream();
+    RandomServices::selectStream((uint32_t)this->id, (uint32_t)playerIndex);
+    this->allocatePlayer(playerIndex, this->playerSelection[playerIndex]);
+    this->players[playerIndex]->solveMaze();
+    RandomServices::setStream(previousStream);
 }
 
 /**
@@ -135,9 +161,9 @@ std::map<Player::Types, std::vector<double>> Run::prepareTimings() {
  * 
  * @return the policies of all the players
  */
-std::map<Player::Types, std::map<std::tuple<int, int, Maze::Actions>, double>> Run::preparePolicies() {
+std::map<Player::Types, std::vector<double>> Run::preparePolicies() {
     int playerIndex;
-    std::map<Player::Types, std::map<std::tuple<int, int, Maze::Actions>, double>> playerPolicies;
+    std::map<Player::Types, std::vector<double>> playerPolicies;
     for (playerIndex = 0; playerIndex < (int)this->players.size(); playerIndex++) {
         playerPolicies[this->playerSelection[playerIndex]] = this->players[playerIndex]->getPolicy();
     }
@@ -181,9 +207,23 @@ void Run::deallocatePlayers() {
     int playerIndex;
     for (playerIndex = 0; playerIndex < (int)this->players.size(); playerIndex++) {
         delete this->players[playerIndex];
+        this->players[playerIndex] = nullptr;
     }
 }
 
+/**
+ * Collects the results of the run, once all its players have been conducted.
+ *
+ * The players are deallocated afterwards.
+ *
+ * @return results of the run (all players) as a Datum
+ */
+Datum Run::collectResults() {
+    this->results = this->datumFromRun();
+    this->deallocatePlayers();
+    return this->results;
+}
+
 /**
  * This function conducts the run for all players in the provided maze.
  * 
@@ -193,9 +233,9 @@ void Run::deallocatePlayers() {
  * @return results of the run (all players) as a Datum
  */
 Datum Run::conductRun() {
-    this->allocatePlayers();
-    this->runAlgorithms();
-    this->results = this->datumFromRun();
-    this->deallocatePlayers();
-    return this->results;
+    int playerIndex;
+    for (playerIndex = 0; playerIndex < this->getPlayerNumber(); playerIndex++) {
+        this->conductPlayer(playerIndex);
+    }
+    return this->collectResults();
 }
@@ -8,8 +8,10 @@
  * @param T The maximum iteration before forcing a stop.
  * @param alpha The learning rate.
  * @param epsilon The exploration rate.
+ * @param lanes The number of episodes to play in lockstep.
  */
-SarsaPlayer::SarsaPlayer(Maze *m, double gamma, int T, double alpha, double epsilon) : TimeDifferencePlayer(m, gamma, T, alpha, epsilon) {
+SarsaPlayer::SarsaPlayer(Maze *m, double gamma, int T, double alpha, double epsilon, int lanes) :
+        TimeDifferencePlayer(m, gamma, T, alpha, epsilon, lanes) {
     this->updatePolicyUsingQuality();   /* Overwrite parent's policy construction, which was arbitrary. */
 }
 
@@ -23,6 +25,10 @@ SarsaPlayer::~SarsaPlayer() = default;
  * whilst learning from doing so.
  */
 void SarsaPlayer::solveMaze() {
+    if (this->batch != nullptr) {
+        this->solveMazeInBatches();
+        return;
+    }
     do {
         auto startTime = std::chrono::high_resolution_clock::now();
         this->performIteration();
@@ -36,7 +42,7 @@ void SarsaPlayer::solveMaze() {
  * player tries to navigate the maze. Every iteration adds 1 to the current epoch.
  */
 void SarsaPlayer::performIteration() {
-    std::tuple<State*, Maze::Actions> startStateActionPair;
+    std::tuple<int, Maze::Actions> startStateActionPair;
     startStateActionPair = this->initialStateActionPair();
     this->generateEpisode(startStateActionPair);
     this->addRewardsToTotalRewardPerEpisode();
@@ -50,73 +56,57 @@ void SarsaPlayer::performIteration() {
  * function continues until the player reached the end of the maze or has reached the maximum
  * amount of steps for an episode.
  */
-void SarsaPlayer::generateEpisode(std::tuple<State*, Maze::Actions> startStateActionPair) {
+void SarsaPlayer::generateEpisode(std::tuple<int, Maze::Actions> startStateActionPair) {
     int currentIteration, maximumIteration;
-    double reward;
-    std::tuple<State*, Maze::Actions> stateActionPair, nextStateActionPair;
+    std::tuple<int, Maze::Actions> stateActionPair, nextStateActionPair;
     currentIteration = -1;
-    maximumIteration = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->stateValues.size());
+    maximumIteration = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->maze->getCellNumber());
     stateActionPair = startStateActionPair;
     do {
         currentIteration++;
         nextStateActionPair = this->nextStateActionPair(stateActionPair);
-        reward = this->rewards.back();
-        this->quality[stateActionPair] += this->alpha *
-                (reward + (this->discountFactor * this->quality[nextStateActionPair]) - this->quality[stateActionPair]);
-        this->updatePolicyUsingQuality(std::get<0>(stateActionPair));
+        this->learnFromStep(std::get<0>(stateActionPair), std::get<1>(stateActionPair), this->rewards.back(),
+                std::get<0>(nextStateActionPair), std::get<1>(nextStateActionPair));
         stateActionPair = nextStateActionPair;
-    } while (currentIteration < maximumIteration && !Maze::stateIsTerminal(std::get<0>(stateActionPair)));
+    } while (currentIteration < maximumIteration && !this->maze->stateIsTerminal(std::get<0>(stateActionPair)));
     this->maze->resetMaze();
 }
 
+/**
+ * Applies the SARSA update to a state-action pair, and makes the policy of its
+ * state greedy with respect to the updated quality.
+ *
+ * @param s The index of the state acted in.
+ * @param a The action taken.
+ * @param reward The reward obtained for the action.
+ * @param next The index of the resulting state.
+ * @param nextAction The action chosen in the resulting state.
+ */
+void SarsaPlayer::learnFromStep(int s, Maze::Actions a, double reward, int next, Maze::Actions nextAction) {
+    int current, following;
+    current = LearningPlayer::stateActionIndex(std::make_tuple(s, a));
+    following = LearningPlayer::stateActionIndex(std::make_tuple(next, nextAction));
+    this->quality[current] += this->alpha *
+            (reward + (this->discountFactor * this->quality[following]) - this->quality[current]);
+    this->updatePolicyUsingQuality(s);
+}
+
 /**
  * This function loops through all states and updates for every state the policy using an epsilon-greedy approach.
  * It is epsilon-greedy with respect to the quality of the action.
  */
 void SarsaPlayer::updatePolicyUsingQuality() {
-    State *state;
-    Maze::Actions greedyAction, currentAction;
-    std::vector<State>* states;
-    std::vector<double> newPolicy;
-    double newActionProbability;
-    states = this->maze->getStates();
-    for (int i = 0; i < (int)states->size(); i++) {
-        state = &(states->at(i));
-        greedyAction = this->greedyAction(state);
-        for (int actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-            currentAction = Maze::actionFromIndex(actionIndex);
-            if (currentAction == greedyAction) {
-                newActionProbability = (this->epsilon / (double)Maze::ACTION_NUMBER) + 1.0 - this->epsilon;
-            } else {
-                newActionProbability = (this->epsilon / (double)Maze::ACTION_NUMBER);
-            }
-            newPolicy.push_back(newActionProbability);
-        }
-        this->policy[state] = newPolicy;
-    }
+    this->quality.greedyActions(&this->greedyActions);
 }
 
 /**
  * This function updates the policy of the provided state using an epsilon-greedy approach.
  * It is epsilon-greedy for the quality.
  * 
- * @param state The state for which we update the policy
+ * @param state The index of the state for which we update the policy
  */
-void SarsaPlayer::updatePolicyUsingQuality(State *state) {
-    Maze::Actions greedyAction, currentAction;
-    std::vector<double> newPolicy;
-    double newActionProbability;
-    greedyAction = this->greedyAction(state);
-    for (int actionIndex = 0; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-        currentAction = Maze::actionFromIndex(actionIndex);
-        if (currentAction == greedyAction) {
-            newActionProbability = (this->epsilon / (double)Maze::ACTION_NUMBER) + 1.0 - this->epsilon;
-        } else {
-            newActionProbability = (this->epsilon / (double)Maze::ACTION_NUMBER);
-        }
-        newPolicy.push_back(newActionProbability);
-    }
-    this->policy[state] = newPolicy;
+void SarsaPlayer::updatePolicyUsingQuality(int state) {
+    this->setGreedyAction(state, this->greedyAction(state));
 }
 
 /**
@@ -124,8 +114,8 @@ void SarsaPlayer::updatePolicyUsingQuality(State *state) {
  * 
  * @return The state action pair where the player should begin
  */
-std::tuple<State*, Maze::Actions> SarsaPlayer::initialStateActionPair() {
-    State *s;
+std::tuple<int, Maze::Actions> SarsaPlayer::initialStateActionPair() {
+    int s;
     Maze::Actions a;
     s = this->maze->getStartingState();
     a = this->chooseAction(s);
@@ -139,9 +129,9 @@ std::tuple<State*, Maze::Actions> SarsaPlayer::initialStateActionPair() {
  * @param currentPair The state which the player is in first combined with the action it's going to do
  * @return The state action pair of the new state the player is in
  */
-std::tuple<State*, Maze::Actions> SarsaPlayer::nextStateActionPair(
-        std::tuple<State*, Maze::Actions> currentPair) {
-    std::tuple<State*, double> result;
+std::tuple<int, Maze::Actions> SarsaPlayer::nextStateActionPair(
+        std::tuple<int, Maze::Actions> currentPair) {
+    std::tuple<int, double> result;
     result = this->maze->getStateTransitionResult(std::get<0>(currentPair), std::get<1>(currentPair));
     this->rewards.push_back(std::get<1>(result));
     return std::make_tuple(std::get<0>(result), this->chooseAction(std::get<0>(result)));
@@ -150,25 +140,9 @@ std::tuple<State*, Maze::Actions> SarsaPlayer::nextStateActionPair(
 /**
  * Returns the action with the highest quality in the provided state.
  *
- * @param s the state for which the action has to be chosen
+ * @param s the index of the state for which the action has to be chosen
  * @return an action
  */
-Maze::Actions SarsaPlayer::greedyAction(State *s) {
-    int actionIndex;
-    std::tuple<State*, Maze::Actions> stateActionPair;
-    Maze::Actions currentAction, bestAction;
-    double current, best;
-    bestAction = Maze::actionFromIndex(0);
-    stateActionPair = std::make_tuple(s, bestAction);
-    best = this->quality[stateActionPair];
-    for (actionIndex = 1; actionIndex < Maze::ACTION_NUMBER; actionIndex++) {
-        currentAction = Maze::actionFromIndex(actionIndex);
-        stateActionPair = std::make_tuple(s, currentAction);
-        current = this->quality[stateActionPair];
-        if (current > best) {
-            bestAction = currentAction;
-            best = current;
-        }
-    }
-    return bestAction;
+Maze::Actions SarsaPlayer::greedyAction(int s) {
+    return this->quality.greedyAction(s);
 }
@@ -0,0 +1,259 @@
+#include <cmath>
+#include <utility>
+#include "SparseSystem.hpp"
+
+/**
+ * Constructs an empty sparse linear system Ax = b.
+ *
+ * @param size The number of unknowns (and equations) of the system.
+ */
+SparseSystem::SparseSystem(int size) {
+    this->clear(size);
+}
+
+/**
+ * Removes all equations from the system.
+ *
+ * Equations are then added one row at a time: first its coefficients through
+ * addCoefficient(), then its constant through finishRow().
+ *
+ * @param size The number of unknowns (and equations) of the system.
+ */
+void SparseSystem::clear(int size) {
+    this->size = size;
+    this->rowOffsets.assign(1, 0);
+    this->columns.clear();
+    this->coefficients.clear();
+    this->constants.clear();
+}
+
+/**
+ * Adds a coefficient to the row currently being built.
+ *
+ * Coefficients for a column already present in the row are summed.
+ *
+ * @param column The unknown the coefficient belongs to.
+ * @param coefficient The coefficient.
+ */
+void SparseSystem::addCoefficient(int column, double coefficient) {
+    int entry;
+    for (entry = this->rowOffsets.back(); entry < (int)this->columns.size(); entry++) {
+        if (this->columns[entry] == column) {
+            this->coefficients[entry] += coefficient;
+            return;
+        }
+    }
+    this->columns.push_back(column);
+    this->coefficients.push_back(coefficient);
+}
+
+/**
+ * Completes the row currently being built.
+ *
+ * @param constant The row's right-hand side.
+ */
+void SparseSystem::finishRow(double constant) {
+    int entry, sortedEntry;
+    /* Rows hold a handful of entries, which insertion sort puts in column order cheaply. */
+    for (entry = this->rowOffsets.back() + 1; entry < (int)this->columns.size(); entry++) {
+        for (sortedEntry = entry; sortedEntry > this->rowOffsets.back() &&
+                this->columns[sortedEntry - 1] > this->columns[sortedEntry]; sortedEntry--) {
+            std::swap(this->columns[sortedEntry - 1], this->columns[sortedEntry]);
+            std::swap(this->coefficients[sortedEntry - 1], this->coefficients[sortedEntry]);
+        }
+    }
+    this->rowOffsets.push_back((int)this->columns.size());
+    this->constants.push_back(constant);
+}
+
+/**
+ * Obtains the number of unknowns of the system.
+ *
+ * @return The number of unknowns.
+ */
+int SparseSystem::getSize() {
+    return this->size;
+}
+
+/**
+ * Computes the product of the system's matrix and a vector.
+ *
+ * @param x The vector to multiply.
+ * @param y Output parameter. The product Ax.
+ */
+void SparseSystem::multiply(const std::vector<double> &x, std::vector<double> *y) {
+    int row, entry;
+    double sum;
+    for (row = 0; row < this->size; row++) {
+        sum = 0.0;
+        for (entry = this->rowOffsets[row]; entry < this->rowOffsets[row + 1]; entry++) {
+            sum += this->coefficients[entry] * x[this->columns[entry]];
+        }
+        (*y)[row] = sum;
+    }
+}
+
+/**
+ * Computes the incomplete LU factorisation of the matrix without fill-in.
+ *
+ * The factors share the matrix's sparsity pattern: the strictly lower part
+ * holds L (whose diagonal is implicitly one), the rest holds U.
+ *
+ * @return Whether the factorisation exists, i.e. no pivot vanished.
+ */
+bool SparseSystem::factorise() {
+    int row, entry, pivotRow, pivotEntry, rowEntry;
+    this->diagonalEntries.assign(this->size, -1);
+    this->factors = this->coefficients;
+    for (row = 0; row < this->size; row++) {
+        for (entry = this->rowOffsets[row]; entry < this->rowOffsets[row + 1]; entry++) {
+            if (this->columns[entry] == row) {
+                this->diagonalEntries[row] = entry;
+            }
+        }
+        if (this->diagonalEntries[row] < 0) {
+            return false;
+        }
+        for (entry = this->rowOffsets[row]; entry < this->diagonalEntries[row]; entry++) {
+            pivotRow = this->columns[entry];
+            this->factors[entry] /= this->factors[this->diagonalEntries[pivotRow]];
+            /* Both rows are sorted by column, so their common columns are found by merging. */
+            pivotEntry = this->diagonalEntries[pivotRow] + 1;
+            rowEntry = entry + 1;
+            while (pivotEntry < this->rowOffsets[pivotRow + 1] && rowEntry < this->rowOffsets[row + 1]) {
+                if (this->columns[pivotEntry] < this->columns[rowEntry]) {
+                    pivotEntry++;
+                } else if (this->columns[rowEntry] < this->columns[pivotEntry]) {
+                    rowEntry++;
+                } else {
+                    this->factors[rowEntry] -= this->factors[entry] * this->factors[pivotEntry];
+                    pivotEntry++, rowEntry++;
+                }
+            }
+        }
+        if (this->factors[this->diagonalEntries[row]] == 0.0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Applies the preconditioner, by solving with the incomplete LU factors.
+ *
+ * @param r The vector to precondition.
+ * @param z Output parameter. The solution of LUz = r.
+ */
+void SparseSystem::precondition(const std::vector<double> &r, std::vector<double> *z) {
+    int row, entry;
+    double sum;
+    for (row = 0; row < this->size; row++) {
+        sum = r[row];
+        for (entry = this->rowOffsets[row]; entry < this->diagonalEntries[row]; entry++) {
+            sum -= this->factors[entry] * (*z)[this->columns[entry]];
+        }
+        (*z)[row] = sum;
+    }
+    for (row = this->size - 1; row >= 0; row--) {
+        sum = (*z)[row];
+        for (entry = this->diagonalEntries[row] + 1; entry < this->rowOffsets[row + 1]; entry++) {
+            sum -= this->factors[entry] * (*z)[this->columns[entry]];
+        }
+        (*z)[row] = sum / this->factors[this->diagonalEntries[row]];
+    }
+}
+
+/**
+ * Computes the inner product of two vectors.
+ *
+ * @param a The first vector.
+ * @param b The second vector.
+ * @return The inner product.
+ */
+double SparseSystem::dot(const std::vector<double> &a, const std::vector<double> &b) {
+    int index;
+    double sum;
+    sum = 0.0;
+    for (index = 0; index < (int)a.size(); index++) {
+        sum += a[index] * b[index];
+    }
+    return sum;
+}
+
+/**
+ * Solves the system by the stabilised biconjugate gradient method (BiCGSTAB),
+ * preconditioned by the matrix's incomplete LU factorisation.
+ *
+ * Iteration stops once the residual's norm has dropped below a fraction of
+ * the right-hand side's. The system need not be symmetric, and the method
+ * does not depend on diagonal dominance to converge.
+ *
+ * @param x Input and output parameter. An initial guess, then the solution.
+ * @return Whether the solver converged. If not, x holds the last iterate.
+ */
+bool SparseSystem::solve(std::vector<double> *x) {
+    int iteration, index;
+    double bound, rho, previousRho, alpha, omega, beta, denominator;
+    std::vector<double> r, rHat, p, pHat, v, s, sHat, t;
+    x->resize(this->size, 0.0);
+    bound = RELATIVE_TOLERANCE * std::sqrt(SparseSystem::dot(this->constants, this->constants));
+    if (!this->factorise()) {
+        return false;
+    }
+    r.resize(this->size);
+    this->multiply(*x, &r);
+    for (index = 0; index < this->size; index++) {
+        r[index] = this->constants[index] - r[index];
+    }
+    if (std::sqrt(SparseSystem::dot(r, r)) <= bound) {
+        return true;
+    }
+    rHat = r;
+    p.assign(this->size, 0.0);
+    v.assign(this->size, 0.0);
+    pHat.resize(this->size);
+    s.resize(this->size);
+    sHat.resize(this->size);
+    t.resize(this->size);
+    previousRho = alpha = omega = 1.0;
+    for (iteration = 0; iteration < ITERATION_LIMIT; iteration++) {
+        rho = SparseSystem::dot(rHat, r);
+        if (rho == 0.0 || omega == 0.0) {
+            /* The method broke down. */
+            return false;
+        }
+        beta = (rho / previousRho) * (alpha / omega);
+        for (index = 0; index < this->size; index++) {
+            p[index] = r[index] + beta * (p[index] - omega * v[index]);
+        }
+        this->precondition(p, &pHat);
+        this->multiply(pHat, &v);
+        denominator = SparseSystem::dot(rHat, v);
+        if (denominator == 0.0) {
+            return false;
+        }
+        alpha = rho / denominator;
+        for (index = 0; index < this->size; index++) {
+            s[index] = r[index] - alpha * v[index];
+        }
+        if (std::sqrt(SparseSystem::dot(s, s)) <= bound) {
+            for (index = 0; index < this->size; index++) {
+                (*x)[index] += alpha * pHat[index];
+            }
+            return true;
+        }
+        this->precondition(s, &sHat);
+        this->multiply(sHat, &t);
+        denominator = SparseSystem::dot(t, t);
+        omega = (denominator == 0.0 ? 0.0 : SparseSystem::dot(t, s) / denominator);
+        for (index = 0; index < this->size; index++) {
+            (*x)[index] += alpha * pHat[index] + omega * sHat[index];
+            r[index] = s[index] - omega * t[index];
+        }
+        if (std::sqrt(SparseSystem::dot(r, r)) <= bound) {
+            return true;
+        }
+        previousRho = rho;
+    }
+    return false;
+}
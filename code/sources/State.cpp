@@ -51,6 +51,15 @@ State::Types State::getType() {
     }
 }
 
+/**
+ * Determines whether the state is currently 'activated'.
+ *
+ * @return The question's answer.
+ */
+bool State::isActivated() {
+    return this->activated;
+}
+
 /**
  * Configures whether the state is 'activated'.
  *
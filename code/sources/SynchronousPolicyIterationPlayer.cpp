@@ -8,32 +8,109 @@
  * @param m The maze to be solved by the player.
  * @param gamma The discount factor to apply to earlier-obtained rewards.
  * @param theta The minimal utility difference to decide to keep iterating.
+ * @param exactEvaluation Should policies be evaluated by solving their linear
+ *      system, rather than by sweeping until values settle?
  */
-SynchronousPolicyIterationPlayer::SynchronousPolicyIterationPlayer(Maze *m, double gamma, double theta) :
-    PolicyIterationPlayer(m, gamma, theta) {}
+SynchronousPolicyIterationPlayer::SynchronousPolicyIterationPlayer(Maze *m, double gamma, double theta,
+        bool exactEvaluation) : PolicyIterationPlayer(m, gamma, theta) {
+    this->exactEvaluation = exactEvaluation;
+    this->indexUnknownStates();
+}
 
 /**
  * Destructs the synchronous policy iteration player.
  */
 SynchronousPolicyIterationPlayer::~SynchronousPolicyIterationPlayer() = default;
 
+/**
+ * Numbers the states whose values are unknown, i.e. the nontrivial ones.
+ *
+ * Terminal and intraversible states keep their values, and enter the policy's
+ * evaluation system as constants. Sweeps visit the unknown states only.
+ */
+void SynchronousPolicyIterationPlayer::indexUnknownStates() {
+    int nontrivialIndex, s;
+    this->unknownIndices.assign(this->space->getStateNumber(), -1);
+    this->unknownStates.clear();
+    for (nontrivialIndex = 0; nontrivialIndex < this->space->getNontrivialStateNumber(); nontrivialIndex++) {
+        s = this->space->getNontrivialState(nontrivialIndex);
+        this->unknownIndices[s] = (int)this->unknownStates.size();
+        this->unknownStates.push_back(s);
+    }
+}
+
+/**
+ * Assembles the current policy's evaluation system (I - gamma P) v = r.
+ *
+ * Each row states that an unknown state's value equals its reward plus the
+ * discounted expected value of its successors under the policy's action.
+ */
+void SynchronousPolicyIterationPlayer::assembleEvaluationSystem() {
+    int unknown, s, i, next;
+    double constant;
+    const Maze::Transition *outcomes;
+    this->evaluationSystem.clear((int)this->unknownStates.size());
+    for (unknown = 0; unknown < (int)this->unknownStates.size(); unknown++) {
+        s = this->unknownStates[unknown];
+        constant = this->space->getReward(s);
+        this->evaluationSystem.addCoefficient(unknown, 1.0);
+        outcomes = this->space->getTransitions(s, this->policyAction(s));
+        for (i = 0; i < Maze::ACTION_NUMBER; i++) {
+            next = outcomes[i].nextIndex;
+            if (this->unknownIndices[next] >= 0) {
+                this->evaluationSystem.addCoefficient(this->unknownIndices[next],
+                        -this->discountFactor * outcomes[i].probability);
+            } else {
+                constant += this->discountFactor * outcomes[i].probability * this->stateValues[next];
+            }
+        }
+        this->evaluationSystem.finishRow(constant);
+    }
+}
+
+/**
+ * Evaluates the current policy exactly, with a single solve of its system.
+ *
+ * The values are left untouched if the solver does not converge.
+ *
+ * @return Whether the policy was evaluated.
+ */
+bool SynchronousPolicyIterationPlayer::performExactEvaluationStep() {
+    int unknown;
+    this->assembleEvaluationSystem();
+    this->solution.resize(this->unknownStates.size());
+    for (unknown = 0; unknown < (int)this->unknownStates.size(); unknown++) {
+        /* The previous policy's values serve as initial guess. */
+        this->solution[unknown] = this->stateValues[this->unknownStates[unknown]];
+    }
+    if (!this->evaluationSystem.solve(&(this->solution))) {
+        return false;
+    }
+    for (unknown = 0; unknown < (int)this->unknownStates.size(); unknown++) {
+        this->stateValues[this->unknownStates[unknown]] = this->solution[unknown];
+    }
+    this->copyStateValues(&(this->stateValues), &(this->oldStateValues));
+    return true;
+}
+
 /**
  * Performs the evaluation step of the policy iteration algorithm.
+ *
+ * Exact evaluation falls back to sweeping when its solver does not converge.
  */
 void SynchronousPolicyIterationPlayer::performEvaluationStep() {
-    int i;
+    int unknown, s;
     double delta, oldValue;
-    State *s;
+    if (this->exactEvaluation && this->performExactEvaluationStep()) {
+        return;
+    }
     do {
         delta = 0.0;
-        for (i = 0; i < (int)this->maze->getStates()->size(); i++) {
-            s = this->maze->getState(i);
-            if (Maze::stateIsIntraversible(s) || Maze::stateIsTerminal(s)) {
-                /* We shouldn't alter these states in any way. */
-                continue;
-            }
+        for (unknown = 0; unknown < (int)this->unknownStates.size(); unknown++) {
+            /* Other states are terminal or unreachable; we shouldn't alter them in any way. */
+            s = this->unknownStates[unknown];
             oldValue = this->stateValues[s];
-            this->stateValues[s] = this->updatedStateValue(s, Maze::actionFromIndex(this->chooseAction(s)));
+            this->stateValues[s] = this->updatedStateValue(s, this->policyAction(s));
             delta = std::max(delta, std::fabs(oldValue - this->stateValues[s]));
         }
         this->copyStateValues(&(this->stateValues), &(this->oldStateValues));
@@ -44,19 +121,19 @@ void SynchronousPolicyIterationPlayer::performEvaluationStep() {
  * Performs the improvement step of the policy iteration algorithm.
  */
 void SynchronousPolicyIterationPlayer::performImprovementStep() {
-    int i;
-    State *s;
+    int unknown, s;
     Maze::Actions current, greedy;
-    for (i = 0; i < (int)this->maze->getStates()->size(); i++) {
-        s = this->maze->getState(i);
-        if (Maze::stateIsIntraversible(s) || Maze::stateIsTerminal(s)) {
-            continue;
-        }
-        current = this->chooseAction(s);
+    for (unknown = 0; unknown < (int)this->unknownStates.size(); unknown++) {
+        s = this->unknownStates[unknown];
+        current = this->policyAction(s);
         greedy = this->greedyActionForState(s);
-        this->policy[s] = Player::actionAsActionProbabilityDistribution(greedy);
-        if (current != greedy && !Maze::stateIsIntraversible(s) &&
-                !Maze::stateIsTerminal(s)) {
+        if (this->exactEvaluation && greedy != current &&
+                this->stateValue(s, greedy) <= this->stateValue(s, current) + IMPROVEMENT_TOLERANCE) {
+            /* Exactly tied actions may differ by rounding only; switching on that would never settle. */
+            greedy = current;
+        }
+        this->setStatePolicy(s, greedy);
+        if (current != greedy && this->space->stateIsNontrivial(s)) {
             this->policyIsStable = false;
         }
     }
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <algorithm>
 #include "SynchronousValueIterationPlayer.hpp"
 
 /**
@@ -7,47 +8,80 @@
  * @param m The maze to be solved by the player.
  * @param gamma The discount factor to apply to earlier-obtained rewards.
  * @param theta The minimal utility difference to decide to keep iterating.
+ * @param threads The number of threads to sweep the states with.
  */
-SynchronousValueIterationPlayer::SynchronousValueIterationPlayer(Maze *m, double gamma, double theta) :
-        ValueIterationPlayer(m, gamma, theta) {}
+SynchronousValueIterationPlayer::SynchronousValueIterationPlayer(Maze *m, double gamma, double theta, int threads) :
+        ValueIterationPlayer(m, gamma, theta) {
+    this->threadPool = new ThreadPool(threads);
+    this->chunkDeltas.resize(this->threadPool->getThreadNumber());
+}
 
 /**
  * Destructs the synchronous value iteration player.
  */
-SynchronousValueIterationPlayer::~SynchronousValueIterationPlayer() = default;
+SynchronousValueIterationPlayer::~SynchronousValueIterationPlayer() {
+    delete this->threadPool;
+}
+
+/**
+ * Backs up a contiguous range of nontrivial states, reading only from the old
+ * values.
+ *
+ * Since ranges neither share reads nor writes, they may be swept in parallel.
+ * Unreachable and terminal states never change, so they are not visited.
+ *
+ * @param begin The first index into the nontrivial states. Inclusive.
+ * @param end The last index into the nontrivial states. Exclusive.
+ * @return The largest change in value within the range.
+ */
+double SynchronousValueIterationPlayer::sweepStates(int begin, int end) {
+    double delta;
+    int nontrivialIndex, s;
+    delta = 0.0;
+    for (nontrivialIndex = begin; nontrivialIndex < end; nontrivialIndex++) {
+        s = this->space->getNontrivialState(nontrivialIndex);
+        this->stateValues[s] = this->updatedStateValue(s);
+        delta = std::max(delta, std::fabs(this->oldStateValues[s] - this->stateValues[s]));
+    }
+    return delta;
+}
 
 /**
  * Performs the repetition step of the synchronous value iteration algorithm.
+ *
+ * Each sweep is split into chunks of states that are backed up in parallel.
+ * The old and new values are kept in two buffers that swap roles after each
+ * sweep. Every state's backup and the maximum over the chunks' deltas do not
+ * depend on how the states are split, so results equal those of a serial run.
  */
 void SynchronousValueIterationPlayer::performRepetitionStep() {
     double delta;
-    int stateIndex;
-    State *s;
+    int chunk;
     do {
         auto startTime = std::chrono::high_resolution_clock::now();
+        std::fill(this->chunkDeltas.begin(), this->chunkDeltas.end(), 0.0);
+        this->threadPool->parallelFor(0, this->space->getNontrivialStateNumber(), [this](int chunk, int begin,
+                int end) {
+            this->chunkDeltas[chunk] = this->sweepStates(begin, end);
+        });
         delta = 0.0;
-        for (stateIndex = 0; stateIndex < (int)this->stateValues.size(); stateIndex++) {
-            s = this->maze->getState(stateIndex);
-            if (Maze::stateIsTerminal(s) || Maze::stateIsIntraversible(s)) {
-                continue;
-            }
-            this->stateValues[s] = this->updatedStateValue(s);
-            delta = std::max(delta, std::fabs(this->oldStateValues[s] - this->stateValues[s]));
+        for (chunk = 0; chunk < (int)this->chunkDeltas.size(); chunk++) {
+            delta = std::max(delta, this->chunkDeltas[chunk]);
         }
-        this->copyStateValues(&(this->stateValues), &(this->oldStateValues));
+        /* Nontrivial states are all overwritten in the next sweep, others never change. */
+        std::swap(this->stateValues, this->oldStateValues);
         auto endTime = std::chrono::high_resolution_clock::now();
         this->epochTimings.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count() / 1e3);
     } while (delta >= this->theta);
+    this->copyStateValues(&(this->oldStateValues), &(this->stateValues));
 }
 
 /**
  * Performs the building step of the synchronous value iteration algorithm.
  */
 void SynchronousValueIterationPlayer::performConstructionStep() {
-    int stateIndex;
-    State *s;
-    for (stateIndex = 0; stateIndex < (int)this->stateValues.size(); stateIndex++) {
-        s = this->maze->getState(stateIndex);
-        this->policy[s] = Player::actionAsActionProbabilityDistribution(this->greedyActionForState(s));
+    int s;
+    for (s = 0; s < this->space->getStateNumber(); s++) {
+        this->setStatePolicy(s, this->greedyActionForState(s));
     }
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <thread>
+#include "TaskScheduler.hpp"
+
+/**
+ * Constructs a work-stealing task scheduler.
+ *
+ * @param workers The number of threads to perform tasks with, including the
+ *      calling one. At least one.
+ */
+TaskScheduler::TaskScheduler(int workers) : queues(workers < 1 ? 1 : workers),
+        queueLocks(workers < 1 ? 1 : workers) {
+    this->workerNumber = (workers < 1 ? 1 : workers);
+}
+
+/**
+ * Obtains the number of threads the scheduler performs tasks with.
+ *
+ * @return The number of workers.
+ */
+int TaskScheduler::getWorkerNumber() {
+    return this->workerNumber;
+}
+
+/**
+ * Takes the next task from the front of the worker's own queue.
+ *
+ * @param worker The index of the worker.
+ * @param task Output parameter. The task taken, if any.
+ * @return Whether a task was taken.
+ */
+bool TaskScheduler::takeOwnTask(int worker, int *task) {
+    std::lock_guard<std::mutex> lock(this->queueLocks[worker]);
+    if (this->queues[worker].empty()) {
+        return false;
+    }
+    *task = this->queues[worker].front();
+    this->queues[worker].pop_front();
+    return true;
+}
+
+/**
+ * Steals a task from the back of another worker's queue.
+ *
+ * Victims are tried in order, starting from the thief's neighbour.
+ *
+ * @param worker The index of the stealing worker.
+ * @param task Output parameter. The task stolen, if any.
+ * @return Whether a task was stolen.
+ */
+bool TaskScheduler::stealTask(int worker, int *task) {
+    int offset, victim;
+    for (offset = 1; offset < this->workerNumber; offset++) {
+        victim = (worker + offset) % this->workerNumber;
+        std::lock_guard<std::mutex> lock(this->queueLocks[victim]);
+        if (!this->queues[victim].empty()) {
+            *task = this->queues[victim].back();
+            this->queues[victim].pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Performs tasks until none are left anywhere.
+ *
+ * Since tasks do not spawn new ones, a worker may stop as soon as all queues
+ * have been found empty.
+ *
+ * @param worker The index of the worker.
+ * @param body The function to perform a task with.
+ */
+void TaskScheduler::work(int worker, const std::function<void(int, int)> &body) {
+    int task;
+    while (this->takeOwnTask(worker, &task) || this->stealTask(worker, &task)) {
+        body(worker, task);
+    }
+}
+
+/**
+ * Performs a number of independent tasks, and returns once all are done.
+ *
+ * Tasks are initially dealt out to the workers in contiguous blocks. Workers
+ * that run out of tasks steal from the others, so that tasks of wildly varying
+ * cost keep all workers busy.
+ *
+ * @param taskNumber The number of tasks; these are numbered from zero.
+ * @param body The function to perform a task with. It receives the index of
+ *      the worker performing it, and the index of the task.
+ */
+void TaskScheduler::run(int taskNumber, const std::function<void(int, int)> &body) {
+    int worker, task;
+    std::vector<std::thread> threads;
+    for (worker = 0; worker < this->workerNumber; worker++) {
+        this->queues[worker].clear();
+        for (task = (int)((long long)taskNumber * worker / this->workerNumber);
+                task < (int)((long long)taskNumber * (worker + 1) / this->workerNumber); task++) {
+            this->queues[worker].push_back(task);
+        }
+    }
+    for (worker = 1; worker < this->workerNumber; worker++) {
+        threads.emplace_back(&TaskScheduler::work, this, worker, std::cref(body));
+    }
+    this->work(0, body);
+    for (worker = 0; worker < (int)threads.size(); worker++) {
+        threads[worker].join();
+    }
+}
\ No newline at end of file
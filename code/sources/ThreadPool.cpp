@@ -0,0 +1,109 @@
+#include <algorithm>
+#include "ThreadPool.hpp"
+
+/**
+ * Constructs a thread pool.
+ *
+ * The calling thread takes part in the work handed to the pool, so only one
+ * less than the given number of threads is spawned.
+ *
+ * @param threads The number of threads to perform work with. At least one.
+ */
+ThreadPool::ThreadPool(int threads) {
+    int workerIndex;
+    this->taskNumber = this->nextTask = this->unfinishedTasks = 0;
+    this->stopping = false;
+    for (workerIndex = 1; workerIndex < threads; workerIndex++) {
+        this->workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+/**
+ * Destructs the thread pool, after its workers have finished.
+ */
+ThreadPool::~ThreadPool() {
+    int workerIndex;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->workAvailable.notify_all();
+    for (workerIndex = 0; workerIndex < (int)this->workers.size(); workerIndex++) {
+        this->workers[workerIndex].join();
+    }
+}
+
+/**
+ * Performs the pending tasks until none are left to claim.
+ *
+ * @param lock The lock on the pool's mutex, held on entry and on exit.
+ */
+void ThreadPool::performTasks(std::unique_lock<std::mutex> *lock) {
+    int taskIndex;
+    while (this->nextTask < this->taskNumber) {
+        taskIndex = this->nextTask++;
+        lock->unlock();
+        this->task(taskIndex);
+        lock->lock();
+        if (--this->unfinishedTasks == 0) {
+            this->workFinished.notify_all();
+        }
+    }
+}
+
+/**
+ * Runs a worker: waits for tasks, and performs them until the pool stops.
+ */
+void ThreadPool::work() {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    while (true) {
+        this->workAvailable.wait(lock, [this] { return this->stopping || this->nextTask < this->taskNumber; });
+        if (this->stopping) {
+            return;
+        }
+        this->performTasks(&lock);
+    }
+}
+
+/**
+ * Obtains the number of threads the pool performs work with.
+ *
+ * @return The number of threads, including the calling one.
+ */
+int ThreadPool::getThreadNumber() {
+    return (int)this->workers.size() + 1;
+}
+
+/**
+ * Splits a range into one contiguous chunk per thread, and processes the
+ * chunks in parallel. Returns once all chunks have been processed.
+ *
+ * The split only depends on the range and the number of threads, so that
+ * per-chunk results can be combined in a reproducible order.
+ *
+ * @param begin The start of the range. Inclusive.
+ * @param end The end of the range. Exclusive.
+ * @param body The function to process a chunk with. It receives the chunk's
+ *      index, and the chunk's start (inclusive) and end (exclusive).
+ */
+void ThreadPool::parallelFor(int begin, int end, const std::function<void(int, int, int)> &body) {
+    int chunks, length;
+    length = end - begin;
+    chunks = std::max(1, std::min(this->getThreadNumber(), length));
+    if (chunks == 1) {
+        body(0, begin, end);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->task = [&body, begin, length, chunks](int chunk) {
+        body(chunk, begin + (int)((long long)length * chunk / chunks),
+                begin + (int)((long long)length * (chunk + 1) / chunks));
+    };
+    this->taskNumber = this->unfinishedTasks = chunks;
+    this->nextTask = 0;
+    this->workAvailable.notify_all();
+    this->performTasks(&lock);
+    this->workFinished.wait(lock, [this] { return this->unfinishedTasks == 0; });
+    this->taskNumber = this->nextTask = 0;
+    this->task = nullptr;
+}
\ No newline at end of file
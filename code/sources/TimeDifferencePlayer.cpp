@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "TimeDifferencePlayer.hpp"
 
 /**
@@ -8,44 +9,122 @@
  * @param T The timeout epoch.
  * @param alpha The learning rate.
  * @param epsilon The exploration rate.
+ * @param lanes The number of episodes to play in lockstep. With a single lane,
+ *      episodes are played one after another, on the player's own maze.
  */
-TimeDifferencePlayer::TimeDifferencePlayer(Maze *m, double gamma, int T, double alpha, double epsilon) :
+TimeDifferencePlayer::TimeDifferencePlayer(Maze *m, double gamma, int T, double alpha, double epsilon, int lanes) :
         LearningPlayer(m, gamma, T) {
     this->alpha = alpha;
     this->epsilon = epsilon;
+    this->useImplicitPolicy(epsilon);
     this->initialiseQuality();
+    this->laneNumber = std::max(lanes, 1);
+    this->batch = nullptr;
+    if (this->laneNumber > 1) {
+        this->batch = new BatchMaze(m->getLayout(), this->laneNumber);
+        this->laneStates.resize(this->laneNumber);
+        this->laneActions.resize(this->laneNumber);
+        this->laneNextStates.resize(this->laneNumber);
+        this->laneRewards.resize(this->laneNumber);
+        this->laneRewardTotals.resize(this->laneNumber);
+        this->laneSteps.resize(this->laneNumber);
+        this->laneDone.resize(this->laneNumber);
+        this->laneActive.resize(this->laneNumber);
+    }
 }
 
 /**
  * Destructs the time-difference player.
  */
-TimeDifferencePlayer::~TimeDifferencePlayer() = default;
+TimeDifferencePlayer::~TimeDifferencePlayer() {
+    delete this->batch;
+}
+
+/**
+ * Plays one episode per lane, all in lockstep, learning from every step.
+ *
+ * All lanes learn from (and act on) the same quality estimates; within a step,
+ * lanes are processed in order, so results do not depend on timing. Episodes
+ * end as they would one at a time: in a terminal state, or on timeout. Their
+ * reward totals are recorded in the order in which they end.
+ */
+void TimeDifferencePlayer::performBatchIteration() {
+    int lane, lanes, activeLanes, maximumIteration;
+    Maze::Actions nextAction;
+    maximumIteration = std::ceil(EPISODE_TIMEOUT_FRACTION * (double)this->maze->getCellNumber());
+    lanes = std::min(this->laneNumber, this->timeoutEpoch - this->currentEpoch);
+    for (lane = 0; lane < this->laneNumber; lane++) {
+        this->laneActive[lane] = (char)(lane < lanes);
+        this->laneDone[lane] = (char)!this->laneActive[lane];
+        if (this->laneActive[lane]) {
+            this->laneStates[lane] = this->batch->startEpisode(lane);
+            this->laneActions[lane] = this->chooseAction(this->laneStates[lane]);
+            this->laneRewardTotals[lane] = 0.0;
+            this->laneSteps[lane] = 0;
+        }
+    }
+    activeLanes = lanes;
+    while (activeLanes > 0) {
+        this->batch->step(this->laneStates.data(), this->laneActions.data(), this->laneNextStates.data(),
+                this->laneRewards.data(), this->laneDone.data());
+        for (lane = 0; lane < this->laneNumber; lane++) {
+            if (!this->laneActive[lane]) {
+                continue;
+            }
+            nextAction = this->chooseAction(this->laneNextStates[lane]);
+            this->learnFromStep(this->laneStates[lane], this->laneActions[lane], this->laneRewards[lane],
+                    this->laneNextStates[lane], nextAction);
+            this->laneRewardTotals[lane] += this->laneRewards[lane];
+            this->laneStates[lane] = this->laneNextStates[lane];
+            this->laneActions[lane] = nextAction;
+            if (this->laneDone[lane] || ++this->laneSteps[lane] > maximumIteration) {
+                this->laneActive[lane] = 0;
+                this->laneDone[lane] = 1;
+                this->totalRewardPerEpisode.push_back(this->laneRewardTotals[lane]);
+                activeLanes--;
+            }
+        }
+    }
+    this->currentEpoch += lanes;
+}
+
+/**
+ * Solves the maze by playing batches of episodes in lockstep, until the
+ * timeout epoch is reached.
+ *
+ * A batch's time is shared evenly among its episodes.
+ */
+void TimeDifferencePlayer::solveMazeInBatches() {
+    int episode, episodes;
+    double elapsed;
+    do {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        episodes = this->currentEpoch;
+        this->performBatchIteration();
+        episodes = this->currentEpoch - episodes;
+        auto endTime = std::chrono::high_resolution_clock::now();
+        elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count() / 1e3;
+        for (episode = 0; episode < episodes; episode++) {
+            this->epochTimings.push_back(elapsed / episodes);
+        }
+    } while (!this->maximumIterationReached());
+}
 
 /**
  * This function initializes the values of quality to zero. Quality is later used to update the
  * policy of a player.
  */
 void TimeDifferencePlayer::initialiseQuality() {
-    int i;
-    State *state;
-    std::vector<State>* states;
-    states = this->maze->getStates();
-    for (i = 0; i < (int)states->size(); i++) {
-        state = &(states->at(i));
-        this->setQuality(state, Maze::Actions::moveUp, INITIAL_QUALITY_VALUE);
-        this->setQuality(state, Maze::Actions::moveRight, INITIAL_QUALITY_VALUE);
-        this->setQuality(state, Maze::Actions::moveDown, INITIAL_QUALITY_VALUE);
-        this->setQuality(state, Maze::Actions::moveLeft, INITIAL_QUALITY_VALUE);
-    }
+    this->quality.assign(this->maze->getStateNumber(), INITIAL_QUALITY_VALUE);
 }
 
 /**
  * This function sets a value in quality of a certain state-action pair to the given value.
  * 
- * @param s The state 
+ * @param s The index of the state
  * @param action The action
  * @param value The quality value for the given state-action pair
  */
-void TimeDifferencePlayer::setQuality(State *s, Maze::Actions action, double value) {
-    this->quality[std::make_tuple(s, action)] = value;
+void TimeDifferencePlayer::setQuality(int s, Maze::Actions action, double value) {
+    this->quality[s * Maze::ACTION_NUMBER + action] = value;
 }
@@ -1,5 +1,7 @@
 #include <RandomServices.hpp>
 #include "UserInput.hpp"
+#include "MazeGenerator.hpp"
+#include "MazeFile.hpp"
 
 /**
  * Asks the user whether he wants to use random mazes from "input/". Returns true if that is the case.
@@ -51,12 +53,14 @@ std::vector<std::string> UserInput::selectedMazes() {
     int repeatIndex;
     std::string currentString;
     std::vector<std::string> mazes;
+    MazeGenerator generator;
     if (UserInput::useRandomPreBuiltMazes()) {
         /* Randomly generate numerous pre-built mazes. */
         return UserInput::randomMazeSelection();
     }
     printf("  Which mazes would you like to use?\n");
-    printf("    Options: Pre-built maze in input/ (excluding .in), or self-built maze (by typing '-').\n");
+    printf("    Options: Pre-built maze in input/ (excluding .in), binary maze in input/ (including .mzb),\n");
+    printf("      generated maze (e.g. generate:prim:1000:7), or self-built maze (by typing '-').\n");
     printf("    Multiple entries possible. Stop by typing 'done'.\n");
     do {
         printf("    Choice: ");
@@ -64,6 +68,18 @@ std::vector<std::string> UserInput::selectedMazes() {
         if (currentString == "-") {
             /* Input maze. */
             mazes.emplace_back("");
+        } else if (MazeGenerator::isSpecification(currentString)) {
+            /* Generated maze. */
+            if (MazeGenerator::fromSpecification(currentString, &generator)) {
+                for (repeatIndex = 0; repeatIndex < UserInput::REPETITION_FACTOR; repeatIndex++) {
+                    mazes.push_back(currentString);
+                }
+            }
+        } else if (MazeFile::isBinary(currentString)) {
+            /* Binary maze. */
+            for (repeatIndex = 0; repeatIndex < UserInput::REPETITION_FACTOR; repeatIndex++) {
+                mazes.push_back("input/" + currentString);
+            }
         } else if (currentString != "done") {
             /* Pre-built maze. */
             for (repeatIndex = 0; repeatIndex < UserInput::REPETITION_FACTOR; repeatIndex++) {
@@ -160,9 +176,10 @@ std::vector<Player::Types> UserInput::selectedPlayers() {
 /**
  * Creates Experiment object with the players and mazes as selected by the user.
  * 
+ * @param configuration The configuration to conduct the experiment with.
  * @return an Experiment with selected players and mazes
  */
-Experiment UserInput::experimentFromUserInput() {
+Experiment UserInput::experimentFromUserInput(Configuration configuration) {
     printf("SPECIFY EXPERIMENT CONDITIONS\n");
-    return Experiment(UserInput::selectedPlayers(), UserInput::selectedMazes());
+    return Experiment(UserInput::selectedPlayers(), UserInput::selectedMazes(), configuration);
 }
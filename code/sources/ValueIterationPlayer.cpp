@@ -17,22 +17,19 @@ ValueIterationPlayer::~ValueIterationPlayer() = default;
 /**
  * Returns the value of the state-action pair.
  *
- * @param s The state of the state-action pair.
+ * @param s The index of the state of the state-action pair.
  * @param a The action of the state-action pair.
  * @return The value of the pair.
  */
-double ValueIterationPlayer::stateActionValue(State *s, Maze::Actions a) {
+double ValueIterationPlayer::stateActionValue(int s, Maze::Actions a) {
     int relativeActionIndex;
-    Maze::Actions action;
-    State *nextState;
-    double nextStateProbability, totalValue;
+    const Maze::Transition *outcomes;
+    double totalValue;
     totalValue = 0.0;
+    outcomes = this->space->getTransitions(s, a);
     for (relativeActionIndex = 0; relativeActionIndex < Maze::ACTION_NUMBER; relativeActionIndex++) {
-        action = Maze::actionFromIndex( (a + relativeActionIndex) % Maze::ACTION_NUMBER );
-        nextState = this->maze->getNextStateDeterministic(s, action);
-        nextStateProbability = this->maze->getActionProbability(relativeActionIndex);
-        totalValue += nextStateProbability * (Maze::getReward(nextState) +
-                this->discountFactor * this->oldStateValues[nextState]);
+        totalValue += outcomes[relativeActionIndex].probability * (outcomes[relativeActionIndex].reward +
+                this->discountFactor * this->backupValue(outcomes[relativeActionIndex].nextIndex));
     }
     return totalValue;
 }
@@ -40,10 +37,10 @@ double ValueIterationPlayer::stateActionValue(State *s, Maze::Actions a) {
 /**
  * Obtains the revised value of the supplied state.
  *
- * @param s The state to calculate a revised value for.
+ * @param s The index of the state to calculate a revised value for.
  * @return The state's revised value.
  */
-double ValueIterationPlayer::updatedStateValue(State *s) {
+double ValueIterationPlayer::updatedStateValue(int s) {
     int actionIndex;
     Maze::Actions a;
     double current, best;
@@ -59,10 +56,10 @@ double ValueIterationPlayer::updatedStateValue(State *s) {
 /**
  * Obtains the greedy action to perform in the supplied state.
  *
- * @param s The state of which to obtain the greedy action.
+ * @param s The index of the state of which to obtain the greedy action.
  * @return The state's greedy action.
  */
-Maze::Actions ValueIterationPlayer::greedyActionForState(State *s) {
+Maze::Actions ValueIterationPlayer::greedyActionForState(int s) {
     int actionIndex;
     Maze::Actions current, best;
     double currentValue, bestValue;